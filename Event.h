@@ -61,8 +61,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1));
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -79,6 +84,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -127,6 +135,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -137,11 +163,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -213,8 +336,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *);
         void (*dtor)(struct event *);
@@ -457,8 +583,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1), a0);
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -475,6 +606,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -523,6 +657,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -533,11 +685,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -609,8 +858,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *, A0 a0);
         void (*dtor)(struct event *);
@@ -853,8 +1105,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1), a0, a1);
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -871,6 +1128,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -919,6 +1179,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -929,11 +1207,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1005,8 +1380,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1);
         void (*dtor)(struct event *);
@@ -1249,8 +1627,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1), a0, a1, a2);
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -1267,6 +1650,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -1315,6 +1701,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -1325,11 +1729,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1401,8 +1902,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2);
         void (*dtor)(struct event *);
@@ -1645,8 +2149,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1), a0, a1, a2, a3);
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -1663,6 +2172,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -1711,6 +2223,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -1721,11 +2251,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1797,8 +2424,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3);
         void (*dtor)(struct event *);
@@ -2041,8 +2671,13 @@ public:
                 }
 
                 new (p) C(*reinterpret_cast<F*>(e+1), a0, a1, a2, a3, a4);
-                equeue_event_delay(p, e->delay);
-                equeue_event_period(p, e->period);
+                equeue_event_delay_ns(p, e->delay);
+                equeue_event_period_ns(p, e->period);
+                equeue_event_slack_ns(p, e->slack);
+                equeue_event_priority(p, e->priority);
+#ifdef EQUEUE_EDF
+                equeue_event_deadline_ns(p, e->deadline);
+#endif
                 equeue_event_dtor(p, &local::dtor);
                 return equeue_post(e->equeue, &local::call, p);
             }
@@ -2059,6 +2694,9 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->slack = 0;
+            _event->priority = 0;
+            _event->deadline = -1;
 
             _event->post = &local::post;
             _event->dtor = &local::dtor;
@@ -2107,6 +2745,24 @@ public:
      *  @param delay    Millisecond delay before dispatching the event
      */
     void delay(int delay) {
+        delay_ns((int64_t)delay*1000000);
+    }
+
+    /** Configure the delay of an event in microseconds
+     *
+     *  @param delay    Microsecond delay before dispatching the event
+     */
+    void delay_us(int64_t delay) {
+        delay_ns(delay*1000);
+    }
+
+    /** Configure the delay of an event in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param delay    Nanosecond delay before dispatching the event
+     */
+    void delay_ns(int64_t delay) {
         if (_event) {
             _event->delay = delay;
         }
@@ -2117,11 +2773,108 @@ public:
      *  @param period   Millisecond period for repeatedly dispatching an event
      */
     void period(int period) {
+        period_ns((int64_t)period*1000000);
+    }
+
+    /** Configure the period of an event in microseconds
+     *
+     *  @param period   Microsecond period for repeatedly dispatching an event
+     */
+    void period_us(int64_t period) {
+        period_ns(period*1000);
+    }
+
+    /** Configure the period of an event in nanoseconds
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param period   Nanosecond period for repeatedly dispatching an event
+     */
+    void period_ns(int64_t period) {
         if (_event) {
             _event->period = period;
         }
     }
 
+    /** Configure the slack of an event
+     *
+     *  An event may be dispatched up to its slack after its delay, which
+     *  lets the event queue coalesce the wakeups of nearby events.
+     *
+     *  @param slack    Millisecond tolerance for dispatching the event late
+     */
+    void slack(int slack) {
+        slack_ns((int64_t)slack*1000000);
+    }
+
+    /** Configure the slack of an event in microseconds
+     *
+     *  @param slack    Microsecond tolerance for dispatching the event late
+     */
+    void slack_us(int64_t slack) {
+        slack_ns(slack*1000);
+    }
+
+    /** Configure the slack of an event in nanoseconds
+     *
+     *  @param slack    Nanosecond tolerance for dispatching the event late
+     */
+    void slack_ns(int64_t slack) {
+        if (_event) {
+            _event->slack = slack;
+        }
+    }
+
+    /** Configure the priority of an event
+     *
+     *  Expired events with a higher priority are dispatched before expired
+     *  events with a lower priority. Priorities range from 0, the default,
+     *  to EQUEUE_PRIORITIES-1.
+     *
+     *  @param priority Priority for dispatching the event
+     */
+    void priority(int priority) {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
+#ifdef EQUEUE_EDF
+    /** Configure the deadline of an event
+     *
+     *  The event's callback must complete within the deadline after the
+     *  event's delay. Expired events are dispatched in order of their
+     *  deadlines, and late completions are counted by
+     *  EventQueue::deadline_misses.
+     *
+     *  @param deadline Millisecond deadline for completing the event
+     */
+    void deadline(int deadline) {
+        deadline_ns((int64_t)deadline*1000000);
+    }
+
+    /** Configure the deadline of an event in microseconds
+     *
+     *  @param deadline Microsecond deadline for completing the event
+     */
+    void deadline_us(int64_t deadline) {
+        deadline_ns(deadline*1000);
+    }
+
+    /** Configure the deadline of an event in nanoseconds
+     *
+     *  The deadline is rounded up to the resolution of the event queue's
+     *  tick.
+     *
+     *  @param deadline Nanosecond deadline for completing the event
+     */
+    void deadline_ns(int64_t deadline) {
+        if (_event) {
+            _event->deadline = deadline;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2193,8 +2946,11 @@ private:
         equeue_t *equeue;
         int id;
 
-        int delay;
-        int period;
+        int64_t delay;
+        int64_t period;
+        int64_t slack;
+        int64_t deadline;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4);
         void (*dtor)(struct event *);
@@ -25,13 +25,41 @@ void EventQueue::break_dispatch() {
 }
 
 unsigned EventQueue::tick() {
-    return equeue_tick();
+    return equeue_tick() / EQUEUE_TICKS_PER_MS;
 }
 
 void EventQueue::cancel(int id) {
     return equeue_cancel(&_equeue, id);
 }
 
+int EventQueue::cancel(const int *ids, int count, bool *results) {
+    return equeue_cancel_many(&_equeue, ids, results, count);
+}
+
+bool EventQueue::reschedule(int id, int ms) {
+    return equeue_reschedule(&_equeue, id, ms);
+}
+
+bool EventQueue::reschedule_us(int id, int64_t us) {
+    return equeue_reschedule_us(&_equeue, id, us);
+}
+
+bool EventQueue::reschedule_ns(int id, int64_t ns) {
+    return equeue_reschedule_ns(&_equeue, id, ns);
+}
+
+#ifdef EQUEUE_EDF
+unsigned EventQueue::deadline_misses() {
+    return equeue_deadline_misses(&_equeue);
+}
+#endif
+
+struct equeue_stats EventQueue::stats() {
+    struct equeue_stats s;
+    equeue_stats(&_equeue, &s);
+    return s;
+}
+
 void EventQueue::background(Callback<void(int)> update) {
     _update = update;
 
@@ -42,6 +70,12 @@ void EventQueue::background(Callback<void(int)> update) {
     }
 }
 
+#ifdef EQUEUE_TIMERFD
+int EventQueue::background_timerfd() {
+    return equeue_background_timerfd(&_equeue);
+}
+#endif
+
 void EventQueue::chain(EventQueue *target) {
     if (target) {
         equeue_chain(&_equeue, &target->_equeue);
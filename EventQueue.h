@@ -39,6 +39,7 @@ namespace events {
 // Predeclared classes
 template <typename F>
 class Event;
+class EventQueueGroup;
 
 
 /** EventQueue
@@ -73,6 +74,10 @@ public:
      *  to terminate. When called with a timeout of 0, the dispatch function
      *  does not wait and is irq safe.
      *
+     *  The dispatch function may be called from multiple threads to run the
+     *  event queue from a pool of workers, in which case callbacks may run
+     *  concurrently.
+     *
      *  @param ms       Time to wait for events in milliseconds, a negative
      *                  value will dispatch events indefinitely
      *                  (default to -1)
@@ -90,8 +95,9 @@ public:
 
     /** Break out of a running event loop
      *
-     *  Forces the specified event queue's dispatch loop to terminate. Pending
-     *  events may finish executing, but no new events will be executed.
+     *  Forces one of the specified event queue's dispatch loops to terminate.
+     *  Pending events may finish executing, but no new events will be
+     *  executed.
      */
     void break_dispatch();
 
@@ -121,6 +127,83 @@ public:
      */
     void cancel(int id);
 
+    /** Cancel a batch of in-flight events
+     *
+     *  Attempts to cancel each of the events referenced by an array of
+     *  unique ids. All events are removed under a single hold of the queue's
+     *  lock and their memory is released in a single batch, which is
+     *  cheaper than cancelling the events individually.
+     *
+     *  The cancel function is irq safe.
+     *
+     *  @param ids      Array of unique ids of the events, ids of 0 are ignored
+     *  @param count    Number of ids in the array
+     *  @param results  Optional array set to true for each event that was
+     *                  cancelled before being dispatched
+     *  @return         The number of events cancelled
+     */
+    int cancel(const int *ids, int count, bool *results = NULL);
+
+    /** Reschedule an in-flight event
+     *
+     *  Moves a pending event referenced by the unique id returned from one
+     *  of the call functions to expire after the specified delay from now.
+     *  The event keeps its id and memory, which is cheaper than cancelling
+     *  the event and calling a new one, for example to refresh a timeout.
+     *  Periodic events continue with their period from the new expiry.
+     *
+     *  The reschedule function is irq safe.
+     *
+     *  @param id       Unique id of the event
+     *  @param ms       Time to delay in milliseconds
+     *  @return         True if the event was rescheduled, false if the event
+     *                  has already been dispatched, cancelled, or is
+     *                  currently executing
+     */
+    bool reschedule(int id, int ms);
+
+    /** Reschedule an in-flight event with a delay in microseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param id       Unique id of the event
+     *  @param us       Time to delay in microseconds
+     *  @return         True if the event was rescheduled
+     *  @see EventQueue::reschedule
+     */
+    bool reschedule_us(int id, int64_t us);
+
+    /** Reschedule an in-flight event with a delay in nanoseconds
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *
+     *  @param id       Unique id of the event
+     *  @param ns       Time to delay in nanoseconds
+     *  @return         True if the event was rescheduled
+     *  @see EventQueue::reschedule
+     */
+    bool reschedule_ns(int id, int64_t ns);
+
+#ifdef EQUEUE_EDF
+    /** Count missed deadlines
+     *
+     *  @return         Number of events that have completed after their
+     *                  deadline since the event queue was created
+     *  @see Event::deadline
+     */
+    unsigned deadline_misses();
+#endif
+
+    /** Query event queue statistics
+     *
+     *  The counters are cheap to maintain and always enabled.
+     *
+     *  @return         Snapshot of the pending events, posts, dispatches,
+     *                  cancels, allocation failures and memory use of the
+     *                  event queue
+     */
+    struct equeue_stats stats();
+
     /** Background an event queue onto a single-shot timer-interrupt
      *
      *  When updated, the event queue will call the provided update function
@@ -139,6 +222,22 @@ public:
      */
     void background(mbed::Callback<void(int)> update);
 
+#ifdef EQUEUE_TIMERFD
+    /** Background an event queue onto a timerfd
+     *
+     *  Starts a thread that sleeps on a Linux timerfd armed for the next
+     *  event and dispatches the event queue when it expires. With
+     *  EQUEUE_HIGHRES the timerfd is armed with nanosecond resolution.
+     *
+     *  This replaces any existing background function, and replacing it
+     *  stops the thread.
+     *
+     *  @return         0 on success or a negative error code
+     *  @see EventQueue::background
+     */
+    int background_timerfd();
+#endif
+
     /** Chain an event queue onto another event queue
      *
      *  After chaining a queue to a target, calling dispatch on the target
@@ -419,6 +518,45 @@ public:
         return call(mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
+    /** Calls a batch of events on the queue
+     *
+     *  Calls the callback once for each of the count arguments. The whole
+     *  batch is allocated and posted with a single acquisition of each of
+     *  the queue's locks and wakes the dispatch loop at most once, which is
+     *  cheaper than calling the events individually.
+     *
+     *  The call_batch function is irq safe.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Array of arguments, one for each event
+     *  @param count    Number of events to call
+     *  @param ids      Optional array the unique ids of the events are
+     *                  written to, an id is 0 if there was not enough
+     *                  memory to allocate the event
+     *  @return         The number of events posted
+     */
+    template <typename F, typename A0>
+    int call_batch(F f, const A0 *args, int count, int *ids = NULL) {
+        typedef context10<F, A0> C;
+        struct batch {
+            F f;
+            const A0 *args;
+        } b = { f, args };
+
+        struct local {
+            static void call(void *p) { (*static_cast<C*>(p))(); }
+            static void dtor(void *p) { static_cast<C*>(p)->~C(); }
+            static void init(void *p, int i, void *data) {
+                batch *b = static_cast<batch*>(data);
+                C *e = new (p) C(b->f, b->args[i]);
+                equeue_event_dtor(e, &local::dtor);
+            }
+        };
+
+        return equeue_emplace_batch(&_equeue, sizeof(C), &local::call,
+                &local::init, &b, ids, count);
+    }
+
     /** Calls an event on the queue after a specified delay
      *
      *  The specified callback will be executed in the context of the event
@@ -452,6 +590,68 @@ public:
         return equeue_post(&_equeue, &local::call, e);
     }
 
+    /** Calls an event on the queue after a microsecond delay
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *  Arguments can be bound to the callback with mbed::callback or an
+     *  Event.
+     *
+     *  @param us       Time to delay in microseconds
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     *  @see EventQueue::call_in
+     */
+    template <typename F>
+    int call_in_us(int64_t us, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay_us(e, us);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *
+     *  The delay is rounded up to the resolution of the event queue's tick.
+     *  Arguments can be bound to the callback with mbed::callback or an
+     *  Event.
+     *
+     *  @param ns       Time to delay in nanoseconds
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     *  @see EventQueue::call_in
+     */
+    template <typename F>
+    int call_in_ns(int64_t ns, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay_ns(e, ns);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
     /** Calls an event on the queue after a specified delay
      *  @see EventQueue::call_in
      */
@@ -684,270 +884,1262 @@ public:
         return call_in(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
-    /** Calls an event on the queue periodically
-     *
-     *  The specified callback will be executed in the context of the event
-     *  queue's dispatch loop.
-     *
-     *  The call_every function is irq safe and can act as a mechanism for
-     *  moving events out of irq contexts.
-     *
-     *  @param f        Function to execute in the context of the dispatch loop
-     *  @param a0..a4   Arguments to pass to the callback
-     *  @param ms       Period of the event in milliseconds
-     *  @return         A unique id that represents the posted event and can
-     *                  be passed to cancel, or an id of 0 if there is not
-     *                  enough memory to allocate the event.
-     */
-    template <typename F>
-    int call_every(int ms, F f) {
-        struct local {
-            static void call(void *p) { (*static_cast<F*>(p))(); }
-            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
-        };
-
-        void *p = equeue_alloc(&_equeue, sizeof(F));
-        if (!p) {
-            return 0;
-        }
-
-        F *e = new (p) F(f);
-        equeue_event_delay(e, ms);
-        equeue_event_period(e, ms);
-        equeue_event_dtor(e, &local::dtor);
-        return equeue_post(&_equeue, &local::call, e);
-    }
-
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename F, typename A0>
-    int call_every(int ms, F f, A0 a0) {
-        return call_every(ms, context10<F, A0>(f, a0));
+    int call_in_us(int64_t us, F f, A0 a0) {
+        return call_in_us(us, context10<F, A0>(f, a0));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename F, typename A0, typename A1>
-    int call_every(int ms, F f, A0 a0, A1 a1) {
-        return call_every(ms, context20<F, A0, A1>(f, a0, a1));
+    int call_in_us(int64_t us, F f, A0 a0, A1 a1) {
+        return call_in_us(us, context20<F, A0, A1>(f, a0, a1));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename F, typename A0, typename A1, typename A2>
-    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    int call_in_us(int64_t us, F f, A0 a0, A1 a1, A2 a2) {
+        return call_in_us(us, context30<F, A0, A1, A2>(f, a0, a1, a2));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3>
-    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+    int call_in_us(int64_t us, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_us(us, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
-    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+    int call_in_us(int64_t us, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_us(us, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R>
-    int call_every(int ms, T *obj, R (T::*method)()) {
-        return call_every(ms, mbed::Callback<void()>(obj, method));
+    int call_in_us(int64_t us, T *obj, R (T::*method)()) {
+        return call_in_us(us, mbed::Callback<void()>(obj, method));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R>
-    int call_every(int ms, const T *obj, R (T::*method)() const) {
-        return call_every(ms, mbed::Callback<void()>(obj, method));
+    int call_in_us(int64_t us, const T *obj, R (T::*method)() const) {
+        return call_in_us(us, mbed::Callback<void()>(obj, method));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R>
-    int call_every(int ms, volatile T *obj, R (T::*method)() volatile) {
-        return call_every(ms, mbed::Callback<void()>(obj, method));
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)() volatile) {
+        return call_in_us(us, mbed::Callback<void()>(obj, method));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R>
-    int call_every(int ms, const volatile T *obj, R (T::*method)() const volatile) {
-        return call_every(ms, mbed::Callback<void()>(obj, method));
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)() const volatile) {
+        return call_in_us(us, mbed::Callback<void()>(obj, method));
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0>
-    int call_every(int ms, T *obj, R (T::*method)(A0), A0 a0) {
-        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    int call_in_us(int64_t us, T *obj, R (T::*method)(A0), A0 a0) {
+        return call_in_us(us, mbed::Callback<void(A0)>(obj, method), a0);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0>
-    int call_every(int ms, const T *obj, R (T::*method)(A0) const, A0 a0) {
-        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    int call_in_us(int64_t us, const T *obj, R (T::*method)(A0) const, A0 a0) {
+        return call_in_us(us, mbed::Callback<void(A0)>(obj, method), a0);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0>
-    int call_every(int ms, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
-        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
+        return call_in_us(us, mbed::Callback<void(A0)>(obj, method), a0);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0>
-    int call_every(int ms, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
-        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
+        return call_in_us(us, mbed::Callback<void(A0)>(obj, method), a0);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1>
-    int call_every(int ms, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
-        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    int call_in_us(int64_t us, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
+        return call_in_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1>
-    int call_every(int ms, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
-        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    int call_in_us(int64_t us, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
+        return call_in_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1>
-    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
-        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
+        return call_in_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1>
-    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
-        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
+        return call_in_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
-    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    int call_in_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
-    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    int call_in_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
-    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
-    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    int call_in_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    int call_in_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    int call_in_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    int call_in_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    int call_in_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
-    /** Calls an event on the queue periodically
-     *  @see EventQueue::call_every
+    /** Calls an event on the queue after a microsecond delay
+     *  @see EventQueue::call_in_us
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    int call_in_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename F, typename A0>
+    int call_in_ns(int64_t ns, F f, A0 a0) {
+        return call_in_ns(ns, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename F, typename A0, typename A1>
+    int call_in_ns(int64_t ns, F f, A0 a0, A1 a1) {
+        return call_in_ns(ns, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_in_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2) {
+        return call_in_ns(ns, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_in_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_ns(ns, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_ns(ns, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)()) {
+        return call_in_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)() const) {
+        return call_in_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)() volatile) {
+        return call_in_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)() const volatile) {
+        return call_in_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)(A0), A0 a0) {
+        return call_in_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)(A0) const, A0 a0) {
+        return call_in_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
+        return call_in_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
+        return call_in_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue after a nanosecond delay
+     *  @see EventQueue::call_in_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_in_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue periodically
+     *
+     *  The specified callback will be executed in the context of the event
+     *  queue's dispatch loop.
+     *
+     *  The call_every function is irq safe and can act as a mechanism for
+     *  moving events out of irq contexts.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @param ms       Period of the event in milliseconds
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_every(int ms, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_period(e, ms);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *  Arguments can be bound to the callback with mbed::callback or an
+     *  Event.
+     *
+     *  @param us       Period of the event in microseconds
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     *  @see EventQueue::call_every
+     */
+    template <typename F>
+    int call_every_us(int64_t us, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay_us(e, us);
+        equeue_event_period_us(e, us);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *
+     *  The period is rounded up to the resolution of the event queue's tick.
+     *  Arguments can be bound to the callback with mbed::callback or an
+     *  Event.
+     *
+     *  @param ns       Period of the event in nanoseconds
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     *  @see EventQueue::call_every
+     */
+    template <typename F>
+    int call_every_ns(int64_t ns, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay_ns(e, ns);
+        equeue_event_period_ns(e, ns);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename A0>
+    int call_every(int ms, F f, A0 a0) {
+        return call_every(ms, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename A0, typename A1>
+    int call_every(int ms, F f, A0 a0, A1 a1) {
+        return call_every(ms, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2) {
+        return call_every(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R>
+    int call_every(int ms, T *obj, R (T::*method)()) {
+        return call_every(ms, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R>
+    int call_every(int ms, const T *obj, R (T::*method)() const) {
+        return call_every(ms, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R>
+    int call_every(int ms, volatile T *obj, R (T::*method)() volatile) {
+        return call_every(ms, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R>
+    int call_every(int ms, const volatile T *obj, R (T::*method)() const volatile) {
+        return call_every(ms, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0>
+    int call_every(int ms, T *obj, R (T::*method)(A0), A0 a0) {
+        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0>
+    int call_every(int ms, const T *obj, R (T::*method)(A0) const, A0 a0) {
+        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0>
+    int call_every(int ms, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
+        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0>
+    int call_every(int ms, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
+        return call_every(ms, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every(int ms, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
+        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every(int ms, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
+        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
+        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
+        return call_every(ms, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue periodically
+     *  @see EventQueue::call_every
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every(ms, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename F, typename A0>
+    int call_every_us(int64_t us, F f, A0 a0) {
+        return call_every_us(us, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename F, typename A0, typename A1>
+    int call_every_us(int64_t us, F f, A0 a0, A1 a1) {
+        return call_every_us(us, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_every_us(int64_t us, F f, A0 a0, A1 a1, A2 a2) {
+        return call_every_us(us, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_every_us(int64_t us, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_us(us, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_us(int64_t us, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_us(us, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R>
+    int call_every_us(int64_t us, T *obj, R (T::*method)()) {
+        return call_every_us(us, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)() const) {
+        return call_every_us(us, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)() volatile) {
+        return call_every_us(us, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)() const volatile) {
+        return call_every_us(us, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_us(int64_t us, T *obj, R (T::*method)(A0), A0 a0) {
+        return call_every_us(us, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)(A0) const, A0 a0) {
+        return call_every_us(us, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
+        return call_every_us(us, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
+        return call_every_us(us, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_us(int64_t us, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
+        return call_every_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
+        return call_every_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
+        return call_every_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
+        return call_every_us(us, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_us(int64_t us, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_us(int64_t us, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_us(int64_t us, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a microsecond period
+     *  @see EventQueue::call_every_us
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_us(int64_t us, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_us(us, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename F, typename A0>
+    int call_every_ns(int64_t ns, F f, A0 a0) {
+        return call_every_ns(ns, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename F, typename A0, typename A1>
+    int call_every_ns(int64_t ns, F f, A0 a0, A1 a1) {
+        return call_every_ns(ns, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_every_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2) {
+        return call_every_ns(ns, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_every_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_ns(ns, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_ns(int64_t ns, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_ns(ns, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)()) {
+        return call_every_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)() const) {
+        return call_every_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)() volatile) {
+        return call_every_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)() const volatile) {
+        return call_every_ns(ns, mbed::Callback<void()>(obj, method));
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)(A0), A0 a0) {
+        return call_every_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)(A0) const, A0 a0) {
+        return call_every_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
+        return call_every_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
+        return call_every_ns(ns, mbed::Callback<void(A0)>(obj, method), a0);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1)>(obj, method), a0, a1);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2)>(obj, method), a0, a1, a2);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3)>(obj, method), a0, a1, a2, a3);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_ns(int64_t ns, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_ns(int64_t ns, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_ns(int64_t ns, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
+    }
+
+    /** Calls an event on the queue with a nanosecond period
+     *  @see EventQueue::call_every_ns
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every_ns(int64_t ns, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+        return call_every_ns(ns, mbed::Callback<void(A0, A1, A2, A3, A4)>(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Creates an event bound to the event queue
@@ -2040,6 +3232,7 @@ public:
 protected:
     template <typename F>
     friend class Event;
+    friend class EventQueueGroup;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
 
@@ -0,0 +1,125 @@
+/* events
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventQueueGroup.h"
+
+#include "mbed_events.h"
+#include "mbed.h"
+#include "rtos.h"
+
+
+struct EventQueueGroup::shard {
+    EventQueueGroup *group;
+    unsigned index;
+    EventQueue queue;
+    rtos::Thread thread;
+    volatile uint8_t waking;
+
+    shard(EventQueueGroup *group, unsigned index, unsigned size)
+        : group(group), index(index), queue(size), waking(0) {}
+
+    void run() {
+        group->dispatch(index);
+    }
+};
+
+EventQueueGroup::EventQueueGroup(unsigned count, unsigned size)
+    : _count(count), _next(0), _stopped(false) {
+    _shards = new shard*[count];
+    for (unsigned i = 0; i < count; i++) {
+        _shards[i] = new shard(this, i, size);
+    }
+
+    // a lone queue has nobody to hand its events to
+    if (count > 1) {
+        for (unsigned i = 0; i < count; i++) {
+            equeue_set_busy_hook(&_shards[i]->queue._equeue,
+                    &EventQueueGroup::busy, _shards[i]);
+        }
+    }
+
+    // dispatchers steal from their siblings, so only start them once
+    // every queue exists
+    for (unsigned i = 0; i < count; i++) {
+        _shards[i]->thread.start(Callback<void()>(_shards[i], &shard::run));
+    }
+}
+
+EventQueueGroup::~EventQueueGroup() {
+    _stopped = true;
+    for (unsigned i = 0; i < _count; i++) {
+        _shards[i]->queue.break_dispatch();
+    }
+
+    for (unsigned i = 0; i < _count; i++) {
+        _shards[i]->thread.join();
+    }
+
+    for (unsigned i = 0; i < _count; i++) {
+        delete _shards[i];
+    }
+    delete[] _shards;
+}
+
+EventQueue *EventQueueGroup::queue(unsigned key) {
+    return &_shards[key % _count]->queue;
+}
+
+EventQueue *EventQueueGroup::next() {
+    return queue(core_util_atomic_incr_u32(&_next, 1));
+}
+
+void EventQueueGroup::busy(void *s) {
+    shard *busy = static_cast<shard*>(s);
+    busy->group->wake(busy->index);
+}
+
+void EventQueueGroup::wake(unsigned index) {
+    // wake the nearest sibling that isn't already being woken, the flag
+    // keeps a burst of posts from breaking the same sibling repeatedly
+    for (unsigned i = 1; i < _count; i++) {
+        shard *sibling = _shards[(index + i) % _count];
+        uint8_t idle = 0;
+        if (core_util_atomic_cas_u8(&sibling->waking, &idle, 1)) {
+            sibling->queue.break_dispatch();
+            return;
+        }
+    }
+}
+
+void EventQueueGroup::dispatch(unsigned index) {
+    shard *self = _shards[index];
+    equeue_t *q = &self->queue._equeue;
+
+    while (!_stopped) {
+        // help out busy siblings before sleeping, our own queue is still
+        // dispatched between each stolen event, a wake that arrives during
+        // the sweep may be for a sibling already passed so sweep again
+        do {
+            self->waking = 0;
+            for (unsigned i = 1; i < _count; i++) {
+                equeue_t *sibling = &_shards[(index + i) % _count]->queue._equeue;
+                while (!_stopped && equeue_steal(sibling)) {
+                    equeue_dispatch(q, 0);
+                }
+            }
+        } while (!_stopped && self->waking);
+
+        // sleep until our own queue has work or a busy sibling wakes us,
+        // breaks are counted so a wake is never lost
+        equeue_dispatch(q, -1);
+    }
+}
@@ -0,0 +1,91 @@
+/* events
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_QUEUE_GROUP_H
+#define EVENT_QUEUE_GROUP_H
+
+#include "EventQueue.h"
+
+namespace events {
+
+/** EventQueueGroup
+ *
+ *  Group of event queues, each dispatched by its own thread
+ *
+ *  Spreading events over several queues avoids contention on a single
+ *  queue's lock. Events are posted to a specific queue in the group,
+ *  either chosen by a key or in round-robin order. When events expire
+ *  on a queue whose dispatcher is busy, an idle dispatcher of another
+ *  queue is woken up to steal them. Idle dispatchers otherwise sleep
+ *  until their own queue has work.
+ */
+class EventQueueGroup {
+public:
+    /** Create an EventQueueGroup
+     *
+     *  Creates the event queues and starts a dispatcher thread for each
+     *  queue. Typically one queue is created for each core.
+     *
+     *  @param count    Number of queues and dispatcher threads
+     *  @param size     Size of buffer to use for each queue's events in
+     *                  bytes (default to EVENTS_QUEUE_SIZE)
+     */
+    EventQueueGroup(unsigned count, unsigned size=EVENTS_QUEUE_SIZE);
+
+    /** Destroy an EventQueueGroup
+     *
+     *  Stops the dispatcher threads before destroying the queues.
+     */
+    ~EventQueueGroup();
+
+    /** Number of queues in the group
+     *
+     *  @return         The number of queues and dispatcher threads
+     */
+    unsigned count() const { return _count; }
+
+    /** Queue selected by a key
+     *
+     *  Events posted with the same key always go to the same queue, so
+     *  they execute in order relative to each other.
+     *
+     *  @param key      Key used to select the queue
+     *  @return         The queue for the key
+     */
+    EventQueue *queue(unsigned key);
+
+    /** Next queue in round-robin order
+     *
+     *  @return         The next queue to post events to
+     */
+    EventQueue *next();
+
+protected:
+    struct shard;
+
+    static void busy(void *s);
+    void wake(unsigned index);
+    void dispatch(unsigned index);
+
+    unsigned _count;
+    uint32_t _next;
+    volatile bool _stopped;
+    shard **_shards;
+};
+
+}
+
+#endif
@@ -232,6 +232,44 @@ void event_inference_test() {
     TEST_ASSERT_EQUAL(counter, 30);
 }
 
+volatile bool group_busy = false;
+volatile uint32_t group_stolen = 0;
+
+void group_block() {
+    group_busy = true;
+    wait_ms(100);
+    group_busy = false;
+}
+
+void group_count() {
+    if (group_busy) {
+        core_util_atomic_incr_u32(&group_stolen, 1);
+    }
+}
+
+template <int N>
+void group_steal_test() {
+    group_stolen = 0;
+    EventQueueGroup group(2);
+
+    // keep the first queue's dispatcher busy
+    EventQueue *busy = group.queue(0);
+    busy->call(group_block);
+    wait_ms(10);
+    TEST_ASSERT(group_busy);
+
+    // events posted to the busy queue are run by its idle sibling
+    for (int i = 0; i < N; i++) {
+        busy->call(group_count);
+    }
+
+    wait_ms(50);
+    TEST_ASSERT_EQUAL(N, group_stolen);
+
+    wait_ms(100);
+    TEST_ASSERT(!group_busy);
+}
+
 
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases) {
@@ -257,6 +295,7 @@ const Case cases[] = {
     Case("Testing the event class", event_class_test),
     Case("Testing the event class helpers", event_class_helper_test),
     Case("Testing the event inference", event_inference_test),
+    Case("Testing queue group stealing", group_steal_test<20>),
 };
 
 Specification specification(test_setup, cases);
@@ -8,29 +8,313 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+
+#if defined(EQUEUE_INGRESS) && !defined(__GNUC__)
+#error "EQUEUE_INGRESS requires __atomic builtins"
+#endif
+
+#if defined(EQUEUE_MAGAZINES) && !defined(__GNUC__)
+#error "EQUEUE_MAGAZINES requires __thread variables and __atomic builtins"
+#endif
+
+#if defined(EQUEUE_TRACE) && !defined(__GNUC__)
+#error "EQUEUE_TRACE requires __thread variables and __atomic builtins"
+#endif
+
+#if defined(EQUEUE_FD) && !defined(__linux__)
+#error "EQUEUE_FD requires eventfd and timerfd from linux"
+#endif
+
+#if defined(EQUEUE_REACTOR) && !defined(__linux__)
+#error "EQUEUE_REACTOR requires epoll from linux"
+#endif
+
+#if defined(EQUEUE_TIMERFD) && !defined(__linux__)
+#error "EQUEUE_TIMERFD requires timerfd from linux"
+#endif
+
+#if defined(EQUEUE_FD) || defined(EQUEUE_REACTOR) || defined(EQUEUE_TIMERFD)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
 
 
 // calculate the relative-difference between absolute times while
 // correctly handling overflow conditions
-static inline int equeue_tickdiff(unsigned a, unsigned b) {
-    return (int)(unsigned)(a - b);
+static inline equeue_delta_t equeue_tickdiff(equeue_tick_t a, equeue_tick_t b) {
+    return (equeue_delta_t)(equeue_tick_t)(a - b);
 }
 
 // calculate the relative-difference between absolute times, but
 // also clamp to zero, resulting in only non-zero values.
-static inline int equeue_clampdiff(unsigned a, unsigned b) {
-    int diff = equeue_tickdiff(a, b);
-    return ~(diff >> (8*sizeof(int)-1)) & diff;
+static inline equeue_delta_t equeue_clampdiff(equeue_tick_t a,
+        equeue_tick_t b) {
+    equeue_delta_t diff = equeue_tickdiff(a, b);
+    return ~(diff >> (8*sizeof(equeue_delta_t)-1)) & diff;
+}
+
+// convert a non-negative tick difference to milliseconds, rounding up so
+// timers never fire early
+static inline int equeue_tickms(equeue_delta_t ticks) {
+#if defined(EQUEUE_HIGHRES)
+    ticks = (ticks + EQUEUE_TICKS_PER_MS-1) / EQUEUE_TICKS_PER_MS;
+    return ticks > INT_MAX ? INT_MAX : (int)ticks;
+#else
+    return ticks;
+#endif
+}
+
+// convert a relative time in nanoseconds to ticks, rounding up, negative
+// times stay negative to keep disabling periods
+static inline equeue_delta_t equeue_nstick(int64_t ns) {
+#if defined(EQUEUE_HIGHRES)
+    return ns;
+#else
+    if (ns < 0) {
+        return -1;
+    }
+
+    ns = (ns + EQUEUE_TICK_NS-1) / EQUEUE_TICK_NS;
+    return ns > INT_MAX ? INT_MAX : (int)ns;
+#endif
 }
 
-// Increment the unique id in an event, hiding the event from cancel
+// Increment the unique id in an event, hiding the event from cancel, the
+// local id sits above the event's offset, and slab index with
+// EQUEUE_SLABS, so it wraps before it would reach the sign bit
 static inline void equeue_incid(equeue_t *q, struct equeue_event *e) {
+#ifdef EQUEUE_SLABS
+    unsigned shift = q->npw2 + EQUEUE_SLAB_BITS;
+#else
+    unsigned shift = q->npw2;
+#endif
     e->id += 1;
-    if (!(e->id << q->npw2)) {
+    if (!e->id || shift >= 31 || e->id >= (1u << (31 - shift))) {
         e->id = 1;
     }
 }
 
+// Carve the id of a new chunk, an overflow slab may be trimmed and grown
+// again at the same index, so the ids of its chunks continue from the
+// largest id any chunk had in the slab before
+static inline void equeue_carveid(equeue_t *q, struct equeue_event *e) {
+#ifndef EQUEUE_COALESCE
+    e->id = 0;
+#endif
+#ifdef EQUEUE_SLABS
+    if (e->slab && e->id < q->slabs[e->slab-1].id) {
+        e->id = q->slabs[e->slab-1].id;
+    }
+#endif
+    equeue_incid(q, e);
+}
+
+#ifdef EQUEUE_SLABS
+// record the id of a chunk that is leaving its overflow slab's pool, the
+// memlock must be held
+static inline void equeue_slab_retire(equeue_t *q, struct equeue_event *e) {
+    if (e->slab && e->id > q->slabs[e->slab-1].id) {
+        q->slabs[e->slab-1].id = e->id;
+    }
+}
+#endif
+
+// find the slab an event was allocated from, the buffer is slab 0
+static inline unsigned equeue_event_slab(struct equeue_event *e) {
+#ifdef EQUEUE_SLABS
+    return e->slab;
+#else
+    (void)e;
+    return 0;
+#endif
+}
+
+static inline unsigned char *equeue_slab_base(equeue_t *q, unsigned slab) {
+#ifdef EQUEUE_SLABS
+    return slab ? q->slabs[slab-1].data : q->buffer;
+#else
+    (void)slab;
+    return q->buffer;
+#endif
+}
+
+#ifdef EQUEUE_COALESCE
+// size of the bitmap of chunk boundaries for a slab, one bit per word
+static inline size_t equeue_starts_size(size_t size) {
+    return ((size/sizeof(void*) + 31) / 32) * sizeof(uint32_t);
+}
+
+// check or mark the start of a chunk in its slab's bitmap, which follows
+// the slab's events
+static inline bool equeue_starts_test(equeue_t *q,
+        unsigned slab, size_t off) {
+    uint32_t *starts = (uint32_t *)(equeue_slab_base(q, slab) + q->slabsize);
+    size_t i = off / sizeof(void*);
+    return starts[i / 32] & ((uint32_t)1 << (i % 32));
+}
+
+static inline void equeue_starts_mark(equeue_t *q,
+        struct equeue_event *e, bool start) {
+    unsigned slab = equeue_event_slab(e);
+    unsigned char *base = equeue_slab_base(q, slab);
+    uint32_t *starts = (uint32_t *)(base + q->slabsize);
+    size_t i = ((unsigned char *)e - base) / sizeof(void*);
+    if (start) {
+        starts[i / 32] |= (uint32_t)1 << (i % 32);
+    } else {
+        starts[i / 32] &= ~((uint32_t)1 << (i % 32));
+    }
+}
+#endif
+
+// hash the local id of an event with its offset in the buffer for a unique
+// id, events in overflow slabs also hash in the index of their slab
+static inline int equeue_event_id(equeue_t *q, struct equeue_event *e) {
+    unsigned slab = equeue_event_slab(e);
+    int off = (unsigned char *)e - equeue_slab_base(q, slab);
+#ifdef EQUEUE_SLABS
+    return (((e->id << EQUEUE_SLAB_BITS) | slab) << q->npw2) | off;
+#else
+    return (e->id << q->npw2) | off;
+#endif
+}
+
+// decode the event a unique id refers to, returns null if the id's overflow
+// slab has been freed or its chunk has been merged
+static inline struct equeue_event *equeue_event_at(equeue_t *q, int id) {
+    unsigned slab = 0;
+#ifdef EQUEUE_SLABS
+    slab = (id >> q->npw2) & ((1 << EQUEUE_SLAB_BITS)-1);
+#endif
+    unsigned char *base = equeue_slab_base(q, slab);
+    size_t off = id & ((1 << q->npw2)-1);
+    if (!base) {
+        return 0;
+    }
+
+#ifdef EQUEUE_COALESCE
+    if (off >= q->slabsize || !equeue_starts_test(q, slab, off) ||
+        ((struct equeue_event *)&base[off])->pooled) {
+        return 0;
+    }
+#endif
+    return (struct equeue_event *)&base[off];
+}
+
+// decode the local id from a unique id
+static inline unsigned equeue_id_local(equeue_t *q, int id) {
+#ifdef EQUEUE_SLABS
+    return id >> (q->npw2 + EQUEUE_SLAB_BITS);
+#else
+    return id >> q->npw2;
+#endif
+}
+
+// idle overflow slabs may be freed and free chunks may be merged at any
+// time, so events decoded from ids are pinned by holding the memlock
+static inline bool equeue_pin(equeue_t *q, int id) {
+#if defined(EQUEUE_COALESCE)
+    equeue_mutex_lock(&q->memlock);
+    return true;
+#elif defined(EQUEUE_SLABS)
+    if ((id >> q->npw2) & ((1 << EQUEUE_SLAB_BITS)-1)) {
+        equeue_mutex_lock(&q->memlock);
+        return true;
+    }
+#endif
+    (void)q;
+    (void)id;
+    return false;
+}
+
+static inline void equeue_unpin(equeue_t *q, bool pinned) {
+    if (pinned) {
+        equeue_mutex_unlock(&q->memlock);
+    }
+}
+
+// find the index of the least-significant set bit in a non-zero mask
+static inline unsigned equeue_ctz(uint32_t mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// hint to the processor that we are busy-waiting, which saves power and
+// yields the core to sibling hardware threads
+static inline void equeue_cpu_relax(void) {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __asm__ volatile ("pause");
+#elif defined(__GNUC__) && (defined(__aarch64__) || \
+        (defined(__arm__) && __ARM_ARCH >= 7))
+    __asm__ volatile ("yield");
+#endif
+}
+
+// find the index of the most-significant set bit in a non-zero tick
+static inline unsigned equeue_msb(equeue_tick_t x) {
+#if defined(__GNUC__) && defined(EQUEUE_HIGHRES)
+    return 63 - __builtin_clzll(x);
+#elif defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    unsigned i = 0;
+    while (x >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+// find the tick an event is scheduled for, this is the most aligned tick
+// within the event's slack so events with overlapping windows coalesce
+// into the same wakeup
+static inline equeue_tick_t equeue_expiry(struct equeue_event *e) {
+    if (e->slack <= 0) {
+        return e->target;
+    }
+
+    // clear the bits below the highest bit that differs between the end
+    // of the window and the tick just before it
+    equeue_tick_t end = e->target + e->slack;
+    unsigned bit = equeue_msb((e->target - 1) ^ end);
+    return end & ~(((equeue_tick_t)1 << bit) - 1);
+}
+
+// find the wheel level for a target, this is the level holding the most
+// significant bit that differs between the target and the wheel's tick
+static inline unsigned equeue_wheel_level(equeue_tick_t tick,
+        equeue_tick_t target) {
+    equeue_tick_t diff = tick ^ target;
+    return diff ? equeue_msb(diff) / EQUEUE_WHEEL_BITS : 0;
+}
+
+// find the slot index for a target at a given wheel level
+static inline unsigned equeue_wheel_index(equeue_tick_t target,
+        unsigned level) {
+    return (target >> (EQUEUE_WHEEL_BITS*level)) & (EQUEUE_WHEEL_SLOTS-1);
+}
+
+// find the first tick covered by a slot, relative to the wheel's tick
+static inline equeue_tick_t equeue_wheel_start(equeue_tick_t tick,
+        unsigned level, unsigned index) {
+    unsigned shift = EQUEUE_WHEEL_BITS*level;
+    equeue_tick_t mask = (level < EQUEUE_WHEEL_LEVELS-1)
+            ? ~(equeue_tick_t)0 << (shift + EQUEUE_WHEEL_BITS) : 0;
+    return (tick & mask) | ((equeue_tick_t)index << shift);
+}
+
 
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size) {
@@ -55,18 +339,97 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
         q->npw2++;
     }
 
-    q->chunks = 0;
+#ifdef EQUEUE_COALESCE
+    // the bitmap of chunk boundaries is kept at the end of the buffer
+    size_t starts = equeue_starts_size(size);
+    if (starts < size) {
+        size = (size - starts) & ~(sizeof(void*)-1);
+        memset((unsigned char *)buffer + size, 0, starts);
+    } else {
+        size = 0;
+    }
+#endif
+
+    q->chunkmap = 0;
+    memset(q->chunks, 0, sizeof(q->chunks));
     q->slab.size = size;
     q->slab.data = buffer;
-
-    q->queue = 0;
+    q->carved = 0;
+    q->carvedhigh = 0;
+    memset(q->pooled, 0, sizeof(q->pooled));
+    q->live = 0;
+    q->failures = 0;
+#if defined(EQUEUE_SLABS) || defined(EQUEUE_COALESCE)
+    q->slabsize = size;
+#endif
+#ifdef EQUEUE_SLABS
+    q->slabindex = 0;
+    memset(q->slabs, 0, sizeof(q->slabs));
+#endif
+
+    memset(&q->wheel, 0, sizeof(q->wheel));
     q->tick = equeue_tick();
-    q->generation = 0;
+    q->readymap = 0;
+    for (unsigned p = 0; p < EQUEUE_PRIORITIES; p++) {
+        q->ready[p] = 0;
+        q->readytail[p] = &q->ready[p];
+    }
+    q->dispatchers = 0;
+    q->sleepers = 0;
     q->breaks = 0;
+#ifdef EQUEUE_EDF
+    q->misses = 0;
+#endif
+#ifdef EQUEUE_HISTOGRAMS
+    memset(&q->lateness, 0, sizeof(q->lateness));
+    memset(&q->runtime, 0, sizeof(q->runtime));
+#endif
+    q->posts = 0;
+    q->dispatches = 0;
+    q->cancels = 0;
+    q->pendinghigh = 0;
+    q->spin = 0;
+    q->spinwindow = 0;
+    q->spins = 0;
+    q->parks = 0;
+    q->sleeping = false;
+    q->wakeup = 0;
+#ifdef EQUEUE_INGRESS
+    q->ingress = 0;
+#endif
+
+#ifdef EQUEUE_FD
+    q->fds.epoll = -1;
+    q->fds.event = -1;
+    q->fds.timer = -1;
+#endif
+
+#ifdef EQUEUE_REACTOR
+    q->reactor.epoll = -1;
+    q->reactor.event = -1;
+#endif
+
+#ifdef EQUEUE_TIMERFD
+    q->timerfd.fd = -1;
+    q->timerfd.running = false;
+    q->timerfd.stop = false;
+#endif
+
+#ifdef EQUEUE_TRACE
+    q->tracehead = 0;
+    memset(q->trace, 0, sizeof(q->trace));
+#endif
+
+    q->busy.hook = 0;
+    q->busy.ctx = 0;
+    q->hooks.before = 0;
+    q->hooks.after = 0;
+    q->hooks.ctx = 0;
 
     q->background.active = false;
     q->background.update = 0;
     q->background.timer = 0;
+    q->background.delta = 0;
 
     // initialize platform resources
     int err;
@@ -85,79 +448,155 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
         return err;
     }
 
+#ifdef EQUEUE_MAGAZINES
+    memset(q->magazines, 0, sizeof(q->magazines));
+#endif
+
     return 0;
 }
 
+static void equeue_ingress_splice(equeue_t *q);
+
+#ifdef EQUEUE_TIMERFD
+static void equeue_timerfd_stop(equeue_t *q);
+#endif
+
 void equeue_destroy(equeue_t *q) {
+#ifdef EQUEUE_TIMERFD
+    // the timerfd thread dispatches the queue, so it must exit first
+    equeue_timerfd_stop(q);
+#endif
+
     // call destructors on pending events
-    for (struct equeue_event *es = q->queue; es; es = es->next) {
-        for (struct equeue_event *e = q->queue; e; e = e->sibling) {
+    equeue_ingress_splice(q);
+    for (unsigned p = 0; p < EQUEUE_PRIORITIES; p++) {
+        for (struct equeue_event *e = q->ready[p]; e; e = e->next) {
             if (e->dtor) {
                 e->dtor(e + 1);
             }
         }
     }
 
+    for (unsigned l = 0; l < EQUEUE_WHEEL_LEVELS; l++) {
+        for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+            for (struct equeue_event *e = q->wheel.slots[l][i];
+                    e; e = e->next) {
+                if (e->dtor) {
+                    e->dtor(e + 1);
+                }
+            }
+        }
+    }
+
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
     }
 
+#ifdef EQUEUE_REACTOR
+    if (q->reactor.epoll >= 0) {
+        close(q->reactor.event);
+        close(q->reactor.epoll);
+    }
+#endif
+
+#ifdef EQUEUE_TIMERFD
+    if (q->timerfd.fd >= 0) {
+        close(q->timerfd.fd);
+    }
+#endif
+
+#ifdef EQUEUE_FD
+    if (q->fds.epoll >= 0) {
+        close(q->fds.timer);
+        close(q->fds.event);
+        close(q->fds.epoll);
+    }
+#endif
+
     // clean up platform resources + memory
     equeue_mutex_destroy(&q->memlock);
     equeue_mutex_destroy(&q->queuelock);
     equeue_sema_destroy(&q->eventsema);
+#ifdef EQUEUE_SLABS
+    for (int i = 0; i < EQUEUE_SLABS; i++) {
+        free(q->slabs[i].data);
+    }
+#endif
     free(q->allocated);
 }
 
 
 // equeue chunk allocation functions
-static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
-    // add event overhead
-    size += sizeof(struct equeue_event);
-    size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
-
-    equeue_mutex_lock(&q->memlock);
-
-    // check if a good chunk is available
-    for (struct equeue_event **p = &q->chunks; *p; p = &(*p)->next) {
-        if ((*p)->size >= size) {
-            struct equeue_event *e = *p;
-            if (e->sibling) {
-                *p = e->sibling;
-                (*p)->next = e->next;
-            } else {
-                *p = e->next;
-            }
+static inline unsigned equeue_chunk_class(size_t size) {
+    size_t words = (size - sizeof(struct equeue_event)) / sizeof(void*);
+    return words < EQUEUE_CHUNK_CLASSES-1 ? words : EQUEUE_CHUNK_CLASSES-1;
+}
 
-            equeue_mutex_unlock(&q->memlock);
-            return e;
-        }
+// count the chunks that are out of the shared pool, in total and for each
+// overflow slab, the memlock must be held
+static inline void equeue_chunk_live(equeue_t *q,
+        struct equeue_event *e, int count) {
+    q->live += count;
+#ifdef EQUEUE_SLABS
+    if (e->slab) {
+        q->slabs[e->slab-1].live += count;
     }
+#else
+    (void)e;
+#endif
+}
 
-    // otherwise allocate a new chunk out of the slab
-    if (q->slab.size >= size) {
-        struct equeue_event *e = (struct equeue_event *)q->slab.data;
-        q->slab.data += size;
-        q->slab.size -= size;
-        e->size = size;
-        e->id = 1;
+// remove a chunk from its class, the memlock must be held
+static struct equeue_event *equeue_chunk_pop(equeue_t *q,
+        unsigned c, struct equeue_event **p) {
+    struct equeue_event *e = *p;
+    if (e->sibling) {
+        *p = e->sibling;
+        (*p)->next = e->next;
+    } else {
+        *p = e->next;
+    }
 
-        equeue_mutex_unlock(&q->memlock);
-        return e;
+    if (!q->chunks[c]) {
+        q->chunkmap &= ~((uint32_t)1 << c);
     }
 
-    equeue_mutex_unlock(&q->memlock);
-    return 0;
+    q->pooled[c] -= e->size;
+    equeue_chunk_live(q, e, +1);
+#ifdef EQUEUE_COALESCE
+    e->pooled = false;
+#endif
+    return e;
 }
 
-static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e) {
-    equeue_mutex_lock(&q->memlock);
+// account for bytes carved out of or returned to the slabs, the memlock
+// must be held
+static inline void equeue_slab_carve(equeue_t *q, size_t size, bool carved) {
+    if (carved) {
+        q->carved += size;
+        if (q->carved > q->carvedhigh) {
+            q->carvedhigh = q->carved;
+        }
+    } else {
+        q->carved -= size;
+    }
+}
 
-    // stick chunk into list of chunks
-    struct equeue_event **p = &q->chunks;
-    while (*p && (*p)->size < e->size) {
-        p = &(*p)->next;
+// stick a chunk into its class, the memlock must be held
+static void equeue_chunk_push(equeue_t *q, struct equeue_event *e) {
+    unsigned c = equeue_chunk_class(e->size);
+    equeue_chunk_live(q, e, -1);
+#ifdef EQUEUE_COALESCE
+    e->pooled = true;
+#endif
+
+    // large chunks are kept sorted by size
+    struct equeue_event **p = &q->chunks[c];
+    if (c == EQUEUE_CHUNK_CLASSES-1) {
+        while (*p && (*p)->size < e->size) {
+            p = &(*p)->next;
+        }
     }
 
     if (*p && (*p)->size == e->size) {
@@ -168,268 +607,1996 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e) {
         e->next = *p;
     }
     *p = e;
-
-    equeue_mutex_unlock(&q->memlock);
+    q->chunkmap |= (uint32_t)1 << c;
+    q->pooled[c] += e->size;
 }
 
-void *equeue_alloc(equeue_t *q, size_t size) {
-    struct equeue_event *e = equeue_mem_alloc(q, size);
-    if (!e) {
-        return 0;
+#ifdef EQUEUE_SLABS
+// move allocation into a new overflow slab, the rest of the current slab
+// is kept as a free chunk, this must be called with the memlock held
+static bool equeue_slab_grow(equeue_t *q, size_t size) {
+    if (size > q->slabsize) {
+        return false;
     }
 
-    e->target = 0;
-    e->period = -1;
-    e->dtor = 0;
+    for (unsigned i = 0; i < EQUEUE_SLABS; i++) {
+        if (q->slabs[i].data) {
+            continue;
+        }
 
-    return e + 1;
-}
+#ifdef EQUEUE_COALESCE
+        size_t starts = equeue_starts_size(q->slabsize);
+#else
+        size_t starts = 0;
+#endif
+        unsigned char *data = malloc(q->slabsize + starts);
+        if (!data) {
+            return false;
+        }
+#ifdef EQUEUE_COALESCE
+        // chunk ids continue from whatever was at their offset, so clear
+        // the slab to keep stale memory from wrapping them into old ids
+        memset(data, 0, q->slabsize + starts);
+#endif
+
+        size_t rest = q->slab.size & ~(sizeof(void*)-1);
+        if (rest >= sizeof(struct equeue_event)) {
+            struct equeue_event *e = (struct equeue_event *)q->slab.data;
+            e->size = rest;
+            e->slab = q->slabindex;
+            equeue_carveid(q, e);
+#ifdef EQUEUE_COALESCE
+            equeue_starts_mark(q, e, true);
+#endif
+            equeue_chunk_live(q, e, +1);
+            equeue_slab_carve(q, rest, true);
+            equeue_chunk_push(q, e);
+        }
 
-void equeue_dealloc(equeue_t *q, void *p) {
-    struct equeue_event *e = (struct equeue_event*)p - 1;
+        q->slabs[i].data = data;
+        q->slabs[i].live = 0;
+        q->slabindex = i+1;
+        q->slab.data = data;
+        q->slab.size = q->slabsize;
+        return true;
+    }
 
-    if (e->dtor) {
-        e->dtor(e+1);
+    return false;
+}
+#endif
+
+#ifdef EQUEUE_COALESCE
+// split the tail off a chunk that is larger than needed and return it to
+// the shared pool, the memlock must be held
+static void equeue_chunk_split(equeue_t *q,
+        struct equeue_event *e, size_t size) {
+    if (e->size - size < sizeof(struct equeue_event)) {
+        return;
     }
 
-    equeue_mem_dealloc(q, e);
+    // the tail's id continues from any chunk that started there before
+    struct equeue_event *r = (struct equeue_event *)((unsigned char *)e + size);
+    r->size = e->size - size;
+    r->ref = 0;
+#ifdef EQUEUE_SLABS
+    r->slab = e->slab;
+#endif
+    equeue_carveid(q, r);
+    equeue_starts_mark(q, r, true);
+    equeue_chunk_live(q, r, +1);
+    equeue_chunk_push(q, r);
+    e->size = size;
 }
 
+// merge neighbouring free chunks by walking each slab, free chunks at the
+// end of the slab being carved are returned to it, returns true if any
+// chunks were merged, the memlock must be held
+static bool equeue_chunk_merge(equeue_t *q) {
+    // take every free chunk out of the shared pool, they are found again
+    // by walking the slabs
+    for (unsigned c = 0; c < EQUEUE_CHUNK_CLASSES; c++) {
+        while (q->chunks[c]) {
+            equeue_chunk_pop(q, c, &q->chunks[c])->pooled = true;
+        }
+    }
 
-// equeue scheduling functions
-static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
-    // setup event and hash local id with buffer offset for unique id
-    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
-    e->target = tick + equeue_clampdiff(e->target, tick);
-    e->generation = q->generation;
+#ifdef EQUEUE_SLABS
+    unsigned slabs = 1 + EQUEUE_SLABS;
+#else
+    unsigned slabs = 1;
+#endif
+
+    bool merged = false;
+    for (unsigned slab = 0; slab < slabs; slab++) {
+        unsigned char *base = equeue_slab_base(q, slab);
+        if (!base) {
+            continue;
+        }
 
-    equeue_mutex_lock(&q->queuelock);
+        // the slab being carved ends at the carve pointer
+        bool carving = q->slab.data != 0;
+#ifdef EQUEUE_SLABS
+        carving = carving && slab == q->slabindex;
+#endif
+        unsigned char *end = carving ? q->slab.data : base + q->slabsize;
+
+        struct equeue_event *run = 0;
+        unsigned char *p = base;
+        while (p + sizeof(struct equeue_event) <= end &&
+               equeue_starts_test(q, slab, p - base)) {
+            struct equeue_event *e = (struct equeue_event *)p;
+            p += e->size;
+
+            if (!e->pooled) {
+                if (run) {
+                    equeue_chunk_push(q, run);
+                    run = 0;
+                }
+            } else if (!run) {
+                run = e;
+            } else {
+                run->size += e->size;
+#ifdef EQUEUE_SLABS
+                equeue_slab_retire(q, e);
+#endif
+                equeue_starts_mark(q, e, false);
+                equeue_chunk_live(q, e, -1);
+                merged = true;
+            }
+        }
 
-    // find the event slot
-    struct equeue_event **p = &q->queue;
-    while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
-        p = &(*p)->next;
+        if (run && carving && p == q->slab.data) {
+            q->slab.data = (unsigned char *)run;
+            q->slab.size += run->size;
+#ifdef EQUEUE_SLABS
+            equeue_slab_retire(q, run);
+#endif
+            equeue_starts_mark(q, run, false);
+            equeue_chunk_live(q, run, -1);
+            equeue_slab_carve(q, run->size, false);
+            merged = true;
+        } else if (run) {
+            equeue_chunk_push(q, run);
+        }
     }
 
-    // insert at head in slot
-    if (*p && (*p)->target == e->target) {
-        e->next = (*p)->next;
-        if (e->next) {
-            e->next->ref = &e->next;
+    return merged;
+}
+#endif
+
+// allocate a chunk from the shared pool, this must be called with the
+// memlock held
+static struct equeue_event *equeue_pool_take(equeue_t *q,
+        size_t size, unsigned c) {
+    // check if a good chunk is available, the smallest non-empty class
+    // that fits is found through the chunkmap
+    uint32_t map = q->chunkmap & (~(uint32_t)0 << c);
+    if (map) {
+        c = equeue_ctz(map);
+        struct equeue_event **p = &q->chunks[c];
+        if (c == EQUEUE_CHUNK_CLASSES-1) {
+            // large chunks are sorted by size with equal sizes as siblings
+            while (*p && (*p)->size < size) {
+                p = &(*p)->next;
+            }
         }
 
-        e->sibling = *p;
-        e->sibling->ref = &e->sibling;
-    } else {
-        e->next = *p;
-        if (e->next) {
-            e->next->ref = &e->next;
+        if (*p) {
+            struct equeue_event *e = equeue_chunk_pop(q, c, p);
+#ifdef EQUEUE_COALESCE
+            equeue_chunk_split(q, e, size);
+#endif
+            return e;
         }
+    }
 
-        e->sibling = 0;
+    // otherwise allocate a new chunk out of the slab
+    if (q->slab.size >= size) {
+        struct equeue_event *e = (struct equeue_event *)q->slab.data;
+        q->slab.data += size;
+        q->slab.size -= size;
+        e->size = size;
+#ifdef EQUEUE_SLABS
+        e->slab = q->slabindex;
+#endif
+        // merged chunks may have been returned to the slab, so with
+        // EQUEUE_COALESCE the id continues from any chunk that started here
+        equeue_carveid(q, e);
+#ifdef EQUEUE_COALESCE
+        e->pooled = false;
+        equeue_starts_mark(q, e, true);
+#endif
+        equeue_chunk_live(q, e, +1);
+        equeue_slab_carve(q, size, true);
+        return e;
     }
 
-    *p = e;
-    e->ref = p;
+#ifdef EQUEUE_COALESCE
+    // merge free chunks before giving up
+    if (equeue_chunk_merge(q)) {
+        return equeue_pool_take(q, size, c);
+    }
+#endif
 
-    // notify background timer
-    if ((q->background.update && q->background.active) &&
-        (q->queue == e && !e->sibling)) {
-        q->background.update(q->background.timer,
-                equeue_clampdiff(e->target, tick));
+#ifdef EQUEUE_SLABS
+    if (equeue_slab_grow(q, size)) {
+        return equeue_pool_take(q, size, c);
     }
+#endif
 
-    equeue_mutex_unlock(&q->queuelock);
+    return 0;
+}
 
-    return id;
+static struct equeue_event *equeue_pool_alloc(equeue_t *q,
+        size_t size, unsigned c) {
+    equeue_mutex_lock(&q->memlock);
+    struct equeue_event *e = equeue_pool_take(q, size, c);
+    equeue_mutex_unlock(&q->memlock);
+    return e;
 }
 
-static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
-    // decode event from unique id and check that the local id matches
-    struct equeue_event *e = (struct equeue_event *)
-            &q->buffer[id & ((1 << q->npw2)-1)];
+// allocate a number of chunks from the shared pool under a single memlock,
+// the chunks are appended to the list at tail, returns the number of chunks
+// allocated
+static int equeue_pool_alloc_batch(equeue_t *q, size_t size, unsigned c,
+        struct equeue_event ***tail, int count) {
+    int i = 0;
+    equeue_mutex_lock(&q->memlock);
+    while (i < count) {
+        struct equeue_event *e = equeue_pool_take(q, size, c);
+        if (!e) {
+            break;
+        }
 
-    equeue_mutex_lock(&q->queuelock);
-    if (e->id != id >> q->npw2) {
-        equeue_mutex_unlock(&q->queuelock);
-        return 0;
+        **tail = e;
+        *tail = &e->next;
+        i++;
     }
+    equeue_mutex_unlock(&q->memlock);
+    **tail = 0;
+    return i;
+}
 
-    // clear the event and check if already in-flight
-    e->cb = 0;
-    e->period = -1;
-
-    int diff = equeue_tickdiff(e->target, q->tick);
-    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
-        equeue_mutex_unlock(&q->queuelock);
-        return 0;
+#if defined(EQUEUE_MAGAZINES) || defined(EQUEUE_TRACE)
+// threads are told apart by the address of a thread-local variable, which
+// is unique to each running thread
+static __thread char equeue_thread;
+#endif
+
+#ifdef EQUEUE_TRACE
+// write a record into the trace ring buffer, the slot is claimed with an
+// atomic increment and its sequence number is cleared while the record is
+// being written so readers can skip it
+static void equeue_trace(equeue_t *q, unsigned type, int id, uint32_t arg) {
+    uint32_t seq = __atomic_fetch_add(&q->tracehead, 1, __ATOMIC_RELAXED);
+    struct equeue_trace_record *r = &q->trace[seq & (EQUEUE_TRACE-1)];
+    __atomic_store_n(&r->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    r->time = (uint64_t)equeue_tick() * EQUEUE_TICK_NS;
+    r->queue = (uint32_t)(uintptr_t)q;
+    r->thread = (uint32_t)(uintptr_t)&equeue_thread;
+    r->id = id;
+    r->arg = arg;
+    r->type = type;
+    __atomic_store_n(&r->seq, seq+1, __ATOMIC_RELEASE);
+}
+#else
+static inline void equeue_trace(equeue_t *q,
+        unsigned type, int id, uint32_t arg) {
+    (void)q;
+    (void)type;
+    (void)id;
+    (void)arg;
+}
+#endif
+
+#ifdef EQUEUE_MAGAZINES
+// magazines are owned by a single thread, identified by the address of
+// equeue_thread, each thread remembers the index of its last magazine to
+// avoid scanning other threads' magazines
+static __thread unsigned equeue_thread_magazine;
+
+static struct equeue_magazine *equeue_magazine(equeue_t *q) {
+    uintptr_t self = (uintptr_t)&equeue_thread;
+    struct equeue_magazine *m = &q->magazines[equeue_thread_magazine];
+    if (__atomic_load_n(&m->owner, __ATOMIC_RELAXED) == self) {
+        return m;
     }
 
-    // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
+    for (unsigned i = 0; i < EQUEUE_MAGAZINES; i++) {
+        if (__atomic_load_n(&q->magazines[i].owner, __ATOMIC_RELAXED) == self) {
+            equeue_thread_magazine = i;
+            return &q->magazines[i];
         }
+    }
 
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
+    // claim a free magazine
+    for (unsigned i = 0; i < EQUEUE_MAGAZINES; i++) {
+        uintptr_t owner = 0;
+        if (__atomic_compare_exchange_n(&q->magazines[i].owner,
+                &owner, self, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            equeue_thread_magazine = i;
+            return &q->magazines[i];
         }
     }
 
-    equeue_incid(q, e);
-    equeue_mutex_unlock(&q->queuelock);
+    return 0;
+}
 
-    return e;
+// only the owner pushes chunks onto or pops chunks off its magazine,
+// other threads can only take a whole list with an atomic exchange, so a
+// popped chunk can't reappear at the head and the pop is free of ABA
+//
+// a pop may still read the next pointer of a chunk that was just taken,
+// overflow slabs can be freed once drained, so pops are marked to let
+// the drain wait them out
+//
+// the added and removed counts are only written by the owner, chunks
+// taken by any thread are counted separately, so the owner never needs
+// more than the one compare-and-swap on the list
+static inline void equeue_magazine_count(unsigned *count, unsigned n) {
+    __atomic_store_n(count, __atomic_load_n(count, __ATOMIC_RELAXED) + n,
+            __ATOMIC_RELAXED);
 }
 
-static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
-    equeue_mutex_lock(&q->queuelock);
+static inline unsigned equeue_magazine_cached(
+        struct equeue_magazine *m, unsigned c) {
+    return __atomic_load_n(&m->added[c], __ATOMIC_RELAXED)
+        - __atomic_load_n(&m->removed[c], __ATOMIC_RELAXED)
+        - __atomic_load_n(&m->taken[c], __ATOMIC_RELAXED);
+}
+
+static struct equeue_event *equeue_magazine_pop(
+        struct equeue_magazine *m, unsigned c) {
+#ifdef EQUEUE_SLABS
+    __atomic_store_n(&m->popping, true, __ATOMIC_SEQ_CST);
+#endif
+    struct equeue_event *e = __atomic_load_n(&m->chunks[c], __ATOMIC_SEQ_CST);
+    while (e && !__atomic_compare_exchange_n(&m->chunks[c], &e, e->next,
+            true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+#ifdef EQUEUE_SLABS
+    __atomic_store_n(&m->popping, false, __ATOMIC_RELEASE);
+#endif
 
-    // find all expired events and mark a new generation
-    q->generation += 1;
-    if (equeue_tickdiff(q->tick, target) <= 0) {
-        q->tick = target;
+    if (e) {
+        equeue_magazine_count(&m->removed[c], 1);
     }
 
-    struct equeue_event *head = q->queue;
-    struct equeue_event **p = &head;
-    while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
-        p = &(*p)->next;
+    return e;
+}
+
+static void equeue_magazine_push(struct equeue_magazine *m, unsigned c,
+        struct equeue_event *head, struct equeue_event *tail,
+        unsigned count) {
+    equeue_magazine_count(&m->added[c], count);
+
+    struct equeue_event *next = __atomic_load_n(&m->chunks[c],
+            __ATOMIC_RELAXED);
+    do {
+        tail->next = next;
+    } while (!__atomic_compare_exchange_n(&m->chunks[c], &next, head,
+            true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+// take all chunks of a class out of a magazine
+static struct equeue_event *equeue_magazine_take(
+        struct equeue_magazine *m, unsigned c) {
+    struct equeue_event *es = __atomic_exchange_n(&m->chunks[c], 0,
+            __ATOMIC_SEQ_CST);
+#ifdef EQUEUE_SLABS
+    while (__atomic_load_n(&m->popping, __ATOMIC_SEQ_CST)) {
+        equeue_cpu_relax();
     }
+#endif
 
-    q->queue = *p;
-    if (q->queue) {
-        q->queue->ref = &q->queue;
+    unsigned count = 0;
+    for (struct equeue_event *e = es; e; e = e->next) {
+        count += 1;
     }
+    __atomic_add_fetch(&m->taken[c], count, __ATOMIC_RELAXED);
 
-    *p = 0;
+    return es;
+}
 
-    equeue_mutex_unlock(&q->queuelock);
+static struct equeue_event *equeue_magazine_alloc(equeue_t *q, unsigned c) {
+    struct equeue_magazine *m = equeue_magazine(q);
+    if (!m) {
+        return 0;
+    }
 
-    // reverse and flatten each slot to match insertion order
-    struct equeue_event **tail = &head;
-    struct equeue_event *ess = head;
-    while (ess) {
-        struct equeue_event *es = ess;
-        ess = es->next;
+    struct equeue_event *e = equeue_magazine_pop(m, c);
+    if (e) {
+        return e;
+    }
 
-        struct equeue_event *prev = 0;
-        for (struct equeue_event *e = es; e; e = e->sibling) {
-            e->next = prev;
-            prev = e;
+    // refill the magazine from the shared chunks in a batch, keeping the
+    // first chunk for ourselves
+    struct equeue_event *head = 0;
+    struct equeue_event *tail = 0;
+    unsigned count = 0;
+    equeue_mutex_lock(&q->memlock);
+    if (q->chunks[c]) {
+        e = equeue_chunk_pop(q, c, &q->chunks[c]);
+    }
+    while (e && q->chunks[c] && count < EQUEUE_MAGAZINE_BATCH-1) {
+        struct equeue_event *r = equeue_chunk_pop(q, c, &q->chunks[c]);
+        r->next = head;
+        head = r;
+        if (!tail) {
+            tail = r;
         }
+        count += 1;
+    }
+    equeue_mutex_unlock(&q->memlock);
 
-        *tail = prev;
-        tail = &es->next;
+    if (head) {
+        equeue_magazine_push(m, c, head, tail, count);
     }
 
-    return head;
+    return e;
 }
 
-int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
-    struct equeue_event *e = (struct equeue_event*)p - 1;
-    unsigned tick = equeue_tick();
-    e->cb = cb;
-    e->target = tick + e->target;
+// returns false if the thread has no magazine
+static bool equeue_magazine_dealloc(equeue_t *q, struct equeue_event *e) {
+    unsigned c = equeue_chunk_class(e->size);
+    struct equeue_magazine *m = equeue_magazine(q);
+    if (!m) {
+        return false;
+    }
 
-    int id = equeue_enqueue(q, e, tick);
-    equeue_sema_signal(&q->eventsema);
-    return id;
-}
+    equeue_magazine_push(m, c, e, e, 1);
+    if (equeue_magazine_cached(m, c) < 2*EQUEUE_MAGAZINE_BATCH) {
+        return true;
+    }
 
-void equeue_cancel(equeue_t *q, int id) {
-    if (!id) {
-        return;
+    // flush all but a batch back to the shared chunks once the magazine
+    // is full
+    struct equeue_event *es = equeue_magazine_take(m, c);
+
+    struct equeue_event *head = 0;
+    struct equeue_event *tail = 0;
+    unsigned count = 0;
+    while (es && count < EQUEUE_MAGAZINE_BATCH) {
+        struct equeue_event *r = es;
+        es = r->next;
+        r->next = head;
+        head = r;
+        if (!tail) {
+            tail = r;
+        }
+        count += 1;
     }
 
-    struct equeue_event *e = equeue_unqueue(q, id);
-    if (e) {
-        equeue_dealloc(q, e + 1);
+    equeue_mutex_lock(&q->memlock);
+    while (es) {
+        struct equeue_event *r = es;
+        es = r->next;
+        equeue_chunk_push(q, r);
     }
+    equeue_mutex_unlock(&q->memlock);
+
+    if (head) {
+        equeue_magazine_push(m, c, head, tail, count);
+    }
+
+    return true;
+}
+
+// return all cached chunks to the shared chunks, returns true if any
+// chunks were found, this may be called from any thread
+static bool equeue_magazine_drain(equeue_t *q) {
+    bool drained = false;
+    for (int i = 0; i < EQUEUE_MAGAZINES; i++) {
+        struct equeue_magazine *m = &q->magazines[i];
+        for (unsigned c = 0; c < EQUEUE_CHUNK_CLASSES-1; c++) {
+            if (!__atomic_load_n(&m->chunks[c], __ATOMIC_RELAXED)) {
+                continue;
+            }
+
+            struct equeue_event *es = equeue_magazine_take(m, c);
+            equeue_mutex_lock(&q->memlock);
+            while (es) {
+                struct equeue_event *e = es;
+                es = e->next;
+                equeue_chunk_push(q, e);
+                drained = true;
+            }
+            equeue_mutex_unlock(&q->memlock);
+        }
+    }
+
+    return drained;
+}
+#endif
+
+#ifdef EQUEUE_SLABS
+// free overflow slabs that have no chunks out of the shared pool, chunks
+// cached in magazines count as out of the pool so the magazines are
+// drained first
+static void equeue_slab_trim(equeue_t *q) {
+    bool overflowing = false;
+    equeue_mutex_lock(&q->memlock);
+    for (unsigned i = 0; i < EQUEUE_SLABS; i++) {
+        overflowing = overflowing || q->slabs[i].data;
+    }
+    equeue_mutex_unlock(&q->memlock);
+
+    if (!overflowing) {
+        return;
+    }
+
+#ifdef EQUEUE_MAGAZINES
+    equeue_magazine_drain(q);
+#endif
+
+    equeue_mutex_lock(&q->memlock);
+    uint32_t idle = 0;
+    for (unsigned i = 0; i < EQUEUE_SLABS; i++) {
+        if (q->slabs[i].data && !q->slabs[i].live) {
+            idle |= (uint32_t)1 << (i+1);
+        }
+    }
+
+    // rebuild the shared pool without the chunks of idle slabs
+    void *trimmed[EQUEUE_SLABS];
+    unsigned count = 0;
+    if (idle) {
+        struct equeue_event *es = 0;
+        for (unsigned c = 0; c < EQUEUE_CHUNK_CLASSES; c++) {
+            while (q->chunks[c]) {
+                struct equeue_event *e = equeue_chunk_pop(q,
+                        c, &q->chunks[c]);
+                e->next = es;
+                es = e;
+            }
+        }
+
+        while (es) {
+            struct equeue_event *e = es;
+            es = e->next;
+            if (!(idle & ((uint32_t)1 << e->slab))) {
+                equeue_chunk_push(q, e);
+            } else {
+                equeue_slab_retire(q, e);
+                equeue_chunk_live(q, e, -1);
+                equeue_slab_carve(q, e->size, false);
+            }
+        }
+
+        for (unsigned i = 0; i < EQUEUE_SLABS; i++) {
+            if (idle & ((uint32_t)1 << (i+1))) {
+                trimmed[count++] = q->slabs[i].data;
+                q->slabs[i].data = 0;
+                q->slabs[i].live = 0;
+
+                if (q->slabindex == i+1) {
+                    q->slabindex = 0;
+                    q->slab.data = 0;
+                    q->slab.size = 0;
+                }
+            }
+        }
+    }
+    equeue_mutex_unlock(&q->memlock);
+
+    for (unsigned i = 0; i < count; i++) {
+        free(trimmed[i]);
+    }
+}
+#endif
+
+static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
+    // add event overhead
+    size += sizeof(struct equeue_event);
+    size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
+    unsigned c = equeue_chunk_class(size);
+
+#ifdef EQUEUE_MAGAZINES
+    // check the thread's magazine before touching the shared chunks
+    if (c < EQUEUE_CHUNK_CLASSES-1) {
+        struct equeue_event *e = equeue_magazine_alloc(q, c);
+        if (e) {
+            return e;
+        }
+    }
+
+    struct equeue_event *e = equeue_pool_alloc(q, size, c);
+    if (!e && equeue_magazine_drain(q)) {
+        // chunks may have been cached by other threads
+        e = equeue_pool_alloc(q, size, c);
+    }
+
+    return e;
+#else
+    return equeue_pool_alloc(q, size, c);
+#endif
+}
+
+// allocate up to count chunks as a list linked through their next
+// pointers, returns the number of chunks allocated
+static int equeue_mem_alloc_batch(equeue_t *q, size_t size,
+        struct equeue_event **es, int count) {
+    // add event overhead
+    size += sizeof(struct equeue_event);
+    size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
+    unsigned c = equeue_chunk_class(size);
+
+    struct equeue_event **tail = es;
+    int i = 0;
+#ifdef EQUEUE_MAGAZINES
+    // use up the thread's magazine before touching the shared chunks
+    while (i < count && c < EQUEUE_CHUNK_CLASSES-1) {
+        struct equeue_event *e = equeue_magazine_alloc(q, c);
+        if (!e) {
+            break;
+        }
+
+        *tail = e;
+        tail = &e->next;
+        i++;
+    }
+
+    i += equeue_pool_alloc_batch(q, size, c, &tail, count-i);
+    if (i < count && equeue_magazine_drain(q)) {
+        // chunks may have been cached by other threads
+        i += equeue_pool_alloc_batch(q, size, c, &tail, count-i);
+    }
+#else
+    i += equeue_pool_alloc_batch(q, size, c, &tail, count-i);
+#endif
+
+    return i;
+}
+
+static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e) {
+#ifdef EQUEUE_MAGAZINES
+    if (equeue_chunk_class(e->size) < EQUEUE_CHUNK_CLASSES-1 &&
+            equeue_magazine_dealloc(q, e)) {
+        return;
+    }
+#endif
+
+    equeue_mutex_lock(&q->memlock);
+    equeue_chunk_push(q, e);
+    equeue_mutex_unlock(&q->memlock);
+}
+
+// return a list of chunks under one hold of the memory lock, these skip
+// the thread's magazine so a mass teardown doesn't just overflow it
+static void equeue_mem_dealloc_batch(equeue_t *q, struct equeue_event *es) {
+    if (!es) {
+        return;
+    }
+
+    equeue_mutex_lock(&q->memlock);
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        equeue_chunk_push(q, e);
+    }
+    equeue_mutex_unlock(&q->memlock);
+}
+
+// setup a freshly allocated event with the default configuration
+static inline void equeue_event_init(struct equeue_event *e) {
+    e->target = 0;
+    e->period = -1;
+    e->slack = 0;
+    e->priority = 0;
+#ifdef EQUEUE_EDF
+    e->deadline = -1;
+#endif
+    e->dtor = 0;
+}
+
+void *equeue_alloc(equeue_t *q, size_t size) {
+    struct equeue_event *e = equeue_mem_alloc(q, size);
+    if (!e) {
+        equeue_mutex_lock(&q->memlock);
+        q->failures += 1;
+        equeue_mutex_unlock(&q->memlock);
+        equeue_trace(q, EQUEUE_TRACE_ALLOCFAIL, 0, size);
+        return 0;
+    }
+
+    equeue_event_init(e);
+    return e + 1;
+}
+
+// allocate a batch of events as a list linked through their next pointers,
+// returns the number of events allocated
+static int equeue_alloc_list(equeue_t *q, size_t size,
+        struct equeue_event **es, int count) {
+    int n = equeue_mem_alloc_batch(q, size, es, count);
+    if (n < count) {
+        equeue_mutex_lock(&q->memlock);
+        q->failures += count - n;
+        equeue_mutex_unlock(&q->memlock);
+        equeue_trace(q, EQUEUE_TRACE_ALLOCFAIL, 0, size);
+    }
+
+    for (struct equeue_event *e = *es; e; e = e->next) {
+        equeue_event_init(e);
+    }
+
+    return n;
+}
+
+int equeue_alloc_batch(equeue_t *q, size_t size, void **ps, int count) {
+    struct equeue_event *es;
+    int n = equeue_alloc_list(q, size, &es, count);
+    for (int i = 0; i < n; i++) {
+        ps[i] = es + 1;
+        es = es->next;
+    }
+
+    return n;
+}
+
+void equeue_dealloc(equeue_t *q, void *p) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+
+    if (e->dtor) {
+        e->dtor(e+1);
+    }
+
+    equeue_mem_dealloc(q, e);
+}
+
+
+// equeue timing wheel functions
+static void equeue_wheel_insert(equeue_t *q, struct equeue_event *e) {
+    // events are never scheduled before the wheel's tick
+    e->target = q->tick + equeue_clampdiff(e->target, q->tick);
+
+    equeue_tick_t expiry = equeue_expiry(e);
+    unsigned level = equeue_wheel_level(q->tick, expiry);
+    unsigned index = equeue_wheel_index(expiry, level);
+
+    // insert at head of slot, slots are kept in reverse insertion order
+    struct equeue_event **p = &q->wheel.slots[level][index];
+    e->next = *p;
+    if (e->next) {
+        e->next->ref = &e->next;
+    }
+
+    *p = e;
+    e->ref = p;
+    q->wheel.map[level] |= (uint32_t)1 << index;
+}
+
+static bool equeue_wheel_first(equeue_t *q,
+        unsigned *level, unsigned *index) {
+    for (unsigned l = 0; l < EQUEUE_WHEEL_LEVELS; l++) {
+        // slots are searched starting at the wheel's tick, this only wraps
+        // around at the top level where targets may overflow
+        unsigned start = equeue_wheel_index(q->tick, l);
+        while (q->wheel.map[l]) {
+            uint32_t map = q->wheel.map[l];
+            if (start) {
+                map = (map >> start) | (map << (EQUEUE_WHEEL_SLOTS-start));
+            }
+            map &= ((uint32_t)2 << (EQUEUE_WHEEL_SLOTS-1)) - 1;
+
+            unsigned i = (start + equeue_ctz(map)) & (EQUEUE_WHEEL_SLOTS-1);
+            if (q->wheel.slots[l][i]) {
+                *level = l;
+                *index = i;
+                return true;
+            }
+
+            // slot was emptied by a cancel, lazily clear it
+            q->wheel.map[l] &= ~((uint32_t)1 << i);
+        }
+    }
+
+    return false;
+}
+
+// find the earliest target in the wheel, if exact is false the start of the
+// earliest slot is returned instead, which may be before the actual target
+static bool equeue_wheel_peek(equeue_t *q, equeue_tick_t *target,
+        bool exact) {
+    unsigned level, index;
+    if (!equeue_wheel_first(q, &level, &index)) {
+        return false;
+    }
+
+    if (level == 0 || !exact) {
+        *target = equeue_wheel_start(q->tick, level, index);
+        return true;
+    }
+
+    struct equeue_event *e = q->wheel.slots[level][index];
+    *target = equeue_expiry(e);
+    for (e = e->next; e; e = e->next) {
+        equeue_tick_t expiry = equeue_expiry(e);
+        if (equeue_tickdiff(expiry, *target) < 0) {
+            *target = expiry;
+        }
+    }
+
+    return true;
+}
+
+// count posted events and track the pending high-water mark, the
+// queuelock must be held
+static inline void equeue_count_posts(equeue_t *q, unsigned count) {
+    q->posts += count;
+    unsigned pending = (unsigned)(q->posts - q->dispatches - q->cancels);
+    if (pending > q->pendinghigh) {
+        q->pendinghigh = pending;
+    }
+}
+
+// equeue ready list functions, expired events are appended to the ready
+// list of their priority and the readymap tracks the non-empty lists
+static inline void equeue_ready_push(equeue_t *q, struct equeue_event *e) {
+    unsigned p = e->priority;
+    e->ref = 0;
+    equeue_trace(q, EQUEUE_TRACE_DEQUEUE, equeue_event_id(q, e), p);
+
+#ifdef EQUEUE_EDF
+    // events with deadlines are kept sorted by deadline ahead of events
+    // without deadlines, equal deadlines stay in order
+    if (e->deadline >= 0) {
+        equeue_tick_t due = e->target + e->deadline;
+        struct equeue_event **r = &q->ready[p];
+        while (*r && (*r)->deadline >= 0 &&
+               equeue_tickdiff((*r)->target + (*r)->deadline, due) <= 0) {
+            r = &(*r)->next;
+        }
+
+        e->next = *r;
+        *r = e;
+        if (!e->next) {
+            q->readytail[p] = &e->next;
+        }
+        q->readymap |= (uint32_t)1 << p;
+        return;
+    }
+#endif
+
+    e->next = 0;
+    *q->readytail[p] = e;
+    q->readytail[p] = &e->next;
+    q->readymap |= (uint32_t)1 << p;
+}
+
+// remove the first event of the highest priority ready list
+static struct equeue_event *equeue_ready_pop(equeue_t *q) {
+    unsigned p = equeue_msb(q->readymap);
+    struct equeue_event *e = q->ready[p];
+    q->ready[p] = e->next;
+    if (!q->ready[p]) {
+        q->readytail[p] = &q->ready[p];
+        q->readymap &= ~((uint32_t)1 << p);
+    }
+
+    e->next = 0;
+    return e;
+}
+
+// remove every ready event, the ready lists are concatenated from the
+// highest to the lowest priority
+static struct equeue_event *equeue_ready_take(equeue_t *q) {
+    struct equeue_event *es = 0;
+    struct equeue_event **tail = &es;
+    while (q->readymap) {
+        unsigned p = equeue_msb(q->readymap);
+        *tail = q->ready[p];
+        tail = q->readytail[p];
+        q->ready[p] = 0;
+        q->readytail[p] = &q->ready[p];
+        q->readymap &= ~((uint32_t)1 << p);
+    }
+
+    return es;
+}
+
+// dispatch loop sleep state, the dispatch loop publishes when it is waiting
+// on the eventsema so posts can skip signalling a busy dispatch loop
+#ifdef EQUEUE_INGRESS
+#define equeue_sleep_load(p) __atomic_load_n(p, __ATOMIC_SEQ_CST)
+#define equeue_sleep_store(p, v) __atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+#else
+#define equeue_sleep_load(p) (*(p))
+#define equeue_sleep_store(p, v) (*(p) = (v))
+#endif
+
+static void equeue_sleep(equeue_t *q, bool sleeping, equeue_tick_t wakeup) {
+    equeue_sleep_store(&q->wakeup, wakeup);
+    equeue_sleep_store(&q->sleeping, sleeping);
+}
+
+// wake up a sleeping dispatch loop, once fds are watched the dispatch loop
+// sleeps in epoll_wait, which is woken through the reactor's eventfd
+static void equeue_signal(equeue_t *q) {
+    equeue_sema_signal(&q->eventsema);
+#ifdef EQUEUE_REACTOR
+    if (__atomic_load_n(&q->reactor.epoll, __ATOMIC_ACQUIRE) >= 0) {
+        uint64_t count = 1;
+        ssize_t res = write(q->reactor.event, &count, sizeof(count));
+        (void)res;
+    }
+#endif
+}
+
+// notify the busy hook of a due event that no sleeping dispatch loop was
+// woken for, the hook is only changed while the queue isn't dispatching
+static inline void equeue_busy(equeue_t *q, bool due) {
+    if (due && q->busy.hook) {
+        q->busy.hook(q->busy.ctx);
+    }
+}
+
+// check if an event needs to wake up the dispatch loop, this is only the
+// case if the dispatch loop is sleeping past the event's target, without
+// the ingress this must be called with the queuelock held
+static bool equeue_wake(equeue_t *q, equeue_tick_t target) {
+    if (!equeue_sleep_load(&q->sleeping) ||
+        equeue_tickdiff(target, equeue_sleep_load(&q->wakeup)) >= 0) {
+        return false;
+    }
+
+#ifdef EQUEUE_INGRESS
+    return __atomic_exchange_n(&q->sleeping, false, __ATOMIC_SEQ_CST);
+#else
+    q->sleeping = false;
+    return true;
+#endif
+}
+
+// disentangle from wheel, emptied slots are cleared lazily
+static inline void equeue_wheel_remove(struct equeue_event *e) {
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    }
+}
+
+// notify the background timer of the delay to the next dispatch, the delay
+// is also kept in ticks for drivers that can use more than milliseconds
+static inline void equeue_background_update(equeue_t *q,
+        equeue_delta_t delta) {
+    q->background.delta = delta;
+    q->background.update(q->background.timer, equeue_tickms(delta));
+}
+
+// equeue scheduling functions
+static void equeue_schedule(equeue_t *q, struct equeue_event *e,
+        equeue_tick_t tick) {
+    // notify background timer if this event is strictly the earliest
+    if (q->background.update && q->background.active) {
+        equeue_tick_t expiry = equeue_expiry(e);
+        equeue_tick_t target;
+        if (!equeue_wheel_peek(q, &target, true) ||
+            equeue_tickdiff(expiry, target) < 0) {
+            equeue_background_update(q, equeue_clampdiff(expiry, tick));
+        }
+    }
+
+    equeue_wheel_insert(q, e);
+    equeue_trace(q, EQUEUE_TRACE_ENQUEUE, equeue_event_id(q, e),
+            equeue_tickms(equeue_clampdiff(e->target, tick)));
+}
+
+static int equeue_enqueue(equeue_t *q, struct equeue_event *e,
+        equeue_tick_t tick) {
+    // setup event and hash local id with buffer offset for unique id
+    int id = equeue_event_id(q, e);
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    bool due = equeue_tickdiff(e->target, tick) <= 0;
+
+    equeue_mutex_lock(&q->queuelock);
+    equeue_schedule(q, e, tick);
+    equeue_count_posts(q, 1);
+    bool wake = equeue_wake(q, equeue_expiry(e));
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (wake) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, due);
+    }
+
+    return id;
+}
+
+#ifndef EQUEUE_INGRESS
+static void equeue_enqueue_batch(equeue_t *q, struct equeue_event *es,
+        int *ids, int count, equeue_tick_t tick) {
+    int i = 0;
+    for (struct equeue_event *e = es; e; e = e->next) {
+        if (ids) {
+            ids[i++] = equeue_event_id(q, e);
+        }
+        e->target = tick + equeue_clampdiff(e->target, tick);
+    }
+
+    // the dispatch loop is signalled at most once for the whole batch
+    bool wake = false;
+    bool due = false;
+    equeue_mutex_lock(&q->queuelock);
+    while (es) {
+        // scheduling relinks the event, so step past it first
+        struct equeue_event *e = es;
+        es = e->next;
+        equeue_schedule(q, e, tick);
+        wake = equeue_wake(q, equeue_expiry(e)) || wake;
+        due = due || equeue_tickdiff(e->target, tick) <= 0;
+    }
+    equeue_count_posts(q, count);
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (wake) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, due);
+    }
+}
+#endif
+
+#ifdef EQUEUE_INGRESS
+static int equeue_ingress(equeue_t *q, struct equeue_event *e,
+        equeue_tick_t tick) {
+    // setup event and hash local id with buffer offset for unique id, a
+    // null ref marks the event as not yet in the wheel
+    int id = equeue_event_id(q, e);
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    e->ref = 0;
+
+    // the event may be dispatched as soon as it is pushed
+    equeue_tick_t expiry = equeue_expiry(e);
+    bool due = equeue_tickdiff(e->target, tick) <= 0;
+
+    struct equeue_event *next = __atomic_load_n(&q->ingress, __ATOMIC_RELAXED);
+    do {
+        e->next = next;
+    } while (!__atomic_compare_exchange_n(&q->ingress, &next, e, true,
+            __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    // a backgrounded queue is not dispatching, so splice the event into
+    // the wheel here to update the background timer
+    if (__atomic_load_n(&q->background.active, __ATOMIC_SEQ_CST)) {
+        equeue_mutex_lock(&q->queuelock);
+        equeue_ingress_splice(q);
+        equeue_mutex_unlock(&q->queuelock);
+    }
+
+    if (equeue_wake(q, expiry)) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, due);
+    }
+
+    return id;
+}
+
+static void equeue_ingress_batch(equeue_t *q, struct equeue_event *es,
+        int *ids, int count, equeue_tick_t tick) {
+    // relink the batch in reverse order to match the newest-first ingress
+    struct equeue_event *head = 0;
+    struct equeue_event *tail = 0;
+    equeue_tick_t expiry = 0;
+    bool due = false;
+    for (int i = 0; i < count; i++) {
+        struct equeue_event *e = es;
+        es = e->next;
+        if (ids) {
+            ids[i] = equeue_event_id(q, e);
+        }
+        e->target = tick + equeue_clampdiff(e->target, tick);
+        e->ref = 0;
+        due = due || equeue_tickdiff(e->target, tick) <= 0;
+
+        if (i == 0 || equeue_tickdiff(equeue_expiry(e), expiry) < 0) {
+            expiry = equeue_expiry(e);
+        }
+
+        e->next = head;
+        head = e;
+        if (!tail) {
+            tail = e;
+        }
+    }
+
+    // push the whole batch at once
+    struct equeue_event *next = __atomic_load_n(&q->ingress, __ATOMIC_RELAXED);
+    do {
+        tail->next = next;
+    } while (!__atomic_compare_exchange_n(&q->ingress, &next, head, true,
+            __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    if (__atomic_load_n(&q->background.active, __ATOMIC_SEQ_CST)) {
+        equeue_mutex_lock(&q->queuelock);
+        equeue_ingress_splice(q);
+        equeue_mutex_unlock(&q->queuelock);
+    }
+
+    if (equeue_wake(q, expiry)) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, due);
+    }
+}
+#endif
+
+// mark the background timer as active, the ingress is spliced afterwards
+// to catch any lock-free posts that raced with the background update
+static void equeue_activate(equeue_t *q, bool active) {
+#ifdef EQUEUE_INGRESS
+    __atomic_store_n(&q->background.active, active, __ATOMIC_SEQ_CST);
+    if (active) {
+        equeue_ingress_splice(q);
+    }
+#else
+    q->background.active = active;
+#endif
+}
+
+// move posted events from the ingress list into the wheel, this must be
+// called with the queuelock held
+static void equeue_ingress_splice(equeue_t *q) {
+#ifdef EQUEUE_INGRESS
+    struct equeue_event *es = __atomic_exchange_n(&q->ingress, 0,
+            __ATOMIC_SEQ_CST);
+    if (!es) {
+        return;
+    }
+
+    // reverse list to match posting order
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    // the tick is only needed to update the background timer, or for the
+    // delay recorded in the trace
+#ifdef EQUEUE_TRACE
+    equeue_tick_t tick = equeue_tick();
+#else
+    equeue_tick_t tick = q->background.update ? equeue_tick() : 0;
+#endif
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+
+        equeue_schedule(q, e, tick);
+        equeue_count_posts(q, 1);
+    }
+#else
+    (void)q;
+#endif
+}
+
+// unlink an event by its unique id, expects queuelock to be held
+static struct equeue_event *equeue_unlink(equeue_t *q, int id) {
+    // decode event from unique id and check that the local id matches
+    bool pinned = equeue_pin(q, id);
+    struct equeue_event *e = equeue_event_at(q, id);
+    if (!e || e->id != equeue_id_local(q, id)) {
+        equeue_unpin(q, pinned);
+        return 0;
+    }
+
+    // events still in the ingress list must reach the wheel first
+    if (!e->ref) {
+        equeue_ingress_splice(q);
+    }
+
+    // clear the event and check if already in-flight, dequeued events
+    // are marked with a null ref
+    e->cb = 0;
+    e->period = -1;
+
+    if (!e->ref) {
+        equeue_unpin(q, pinned);
+        return 0;
+    }
+
+    equeue_wheel_remove(e);
+    equeue_incid(q, e);
+    equeue_unpin(q, pinned);
+    q->cancels += 1;
+    equeue_trace(q, EQUEUE_TRACE_CANCEL, id, 0);
+    return e;
+}
+
+static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
+    equeue_mutex_lock(&q->queuelock);
+    struct equeue_event *e = equeue_unlink(q, id);
+    equeue_mutex_unlock(&q->queuelock);
+    return e;
+}
+
+static struct equeue_event *equeue_dequeue(equeue_t *q,
+        equeue_tick_t target) {
+    equeue_mutex_lock(&q->queuelock);
+
+    // find all expired events and append them to the ready list
+    equeue_ingress_splice(q);
+    if (equeue_tickdiff(target, q->tick) < 0) {
+        target = q->tick;
+    }
+
+    unsigned level, index;
+    while (equeue_wheel_first(q, &level, &index)) {
+        equeue_tick_t start = equeue_wheel_start(q->tick, level, index);
+        if (equeue_tickdiff(start, target) > 0) {
+            break;
+        }
+
+        // advance the wheel to the earliest slot and remove it
+        q->tick = start;
+        struct equeue_event *es = q->wheel.slots[level][index];
+        q->wheel.slots[level][index] = 0;
+        q->wheel.map[level] &= ~((uint32_t)1 << index);
+
+        // reverse slot to match insertion order
+        struct equeue_event *prev = 0;
+        while (es) {
+            struct equeue_event *e = es;
+            es = e->next;
+            e->next = prev;
+            prev = e;
+        }
+
+        if (level == 0) {
+            // all events in a bottom slot share the same target
+            while (prev) {
+                struct equeue_event *e = prev;
+                prev = e->next;
+                equeue_ready_push(q, e);
+            }
+        } else {
+            // cascade events into lower levels
+            while (prev) {
+                struct equeue_event *e = prev;
+                prev = e->next;
+                equeue_wheel_insert(q, e);
+            }
+        }
+    }
+
+    q->tick = target;
+
+    // a lone dispatcher takes every ready event, otherwise events are
+    // handed out one at a time and any remaining events wake up another
+    // sleeping dispatcher or the busy hook, either way higher priorities
+    // go first
+    struct equeue_event *es = 0;
+    if (q->readymap && (q->dispatchers > 1 || q->busy.hook)) {
+        es = equeue_ready_pop(q);
+    } else if (q->readymap) {
+        es = equeue_ready_take(q);
+    }
+
+    bool left = q->readymap != 0;
+    bool wake = left && equeue_wake(q, target);
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (wake) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, left);
+    }
+
+    return es;
+}
+
+int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    equeue_tick_t tick = equeue_tick();
+    e->cb = cb;
+    e->target = tick + e->target;
+    equeue_trace(q, EQUEUE_TRACE_POST, equeue_event_id(q, e),
+            (uint32_t)(uintptr_t)cb);
+
+#ifdef EQUEUE_INGRESS
+    return equeue_ingress(q, e, tick);
+#else
+    return equeue_enqueue(q, e, tick);
+#endif
+}
+
+// post a list of events linked through their next pointers, the whole
+// list is scheduled under a single lock and signals at most once
+static void equeue_post_list(equeue_t *q, void (*cb)(void*),
+        struct equeue_event *es, int *ids, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    equeue_tick_t tick = equeue_tick();
+    for (struct equeue_event *e = es; e; e = e->next) {
+        e->cb = cb;
+        e->target = tick + e->target;
+        equeue_trace(q, EQUEUE_TRACE_POST, equeue_event_id(q, e),
+                (uint32_t)(uintptr_t)cb);
+    }
+
+#ifdef EQUEUE_INGRESS
+    equeue_ingress_batch(q, es, ids, count, tick);
+#else
+    equeue_enqueue_batch(q, es, ids, count, tick);
+#endif
+}
+
+void equeue_post_batch(equeue_t *q, void (*cb)(void*),
+        void **ps, int *ids, int count) {
+    struct equeue_event *es = 0;
+    for (int i = count-1; i >= 0; i--) {
+        struct equeue_event *e = (struct equeue_event*)ps[i] - 1;
+        e->next = es;
+        es = e;
+    }
+
+    equeue_post_list(q, cb, es, ids, count);
+}
+
+int equeue_emplace_batch(equeue_t *q, size_t size, void (*cb)(void*),
+        void (*init)(void *p, int i, void *data), void *data,
+        int *ids, int count) {
+    struct equeue_event *es;
+    int n = equeue_alloc_list(q, size, &es, count);
+    int i = 0;
+    for (struct equeue_event *e = es; e; e = e->next) {
+        init(e + 1, i++, data);
+    }
+
+    equeue_post_list(q, cb, es, ids, n);
+
+    if (ids) {
+        for (i = n; i < count; i++) {
+            ids[i] = 0;
+        }
+    }
+
+    return n;
+}
+
+void equeue_cancel(equeue_t *q, int id) {
+    if (!id) {
+        return;
+    }
+
+    struct equeue_event *e = equeue_unqueue(q, id);
+    if (e) {
+        equeue_dealloc(q, e + 1);
+    }
+}
+
+int equeue_cancel_many(equeue_t *q, const int *ids, bool *results,
+        int count) {
+    // unlink all of the events under one hold of the queue's lock
+    struct equeue_event *es = 0;
+    int cancelled = 0;
+
+    equeue_mutex_lock(&q->queuelock);
+    for (int i = 0; i < count; i++) {
+        struct equeue_event *e = ids[i] ? equeue_unlink(q, ids[i]) : 0;
+        if (e) {
+            e->next = es;
+            es = e;
+            cancelled += 1;
+        }
+
+        if (results) {
+            results[i] = (e != 0);
+        }
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    // destructors run outside of the locks before the memory is returned
+    for (struct equeue_event *e = es; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e+1);
+        }
+    }
+
+    equeue_mem_dealloc_batch(q, es);
+    return cancelled;
+}
+
+void equeue_stats(equeue_t *q, struct equeue_stats *s) {
+    memset(s, 0, sizeof(*s));
+
+    // chunks cached in magazines are free, though out of the shared pool
+    unsigned cached = 0;
+#ifdef EQUEUE_MAGAZINES
+    for (int i = 0; i < EQUEUE_MAGAZINES; i++) {
+        struct equeue_magazine *m = &q->magazines[i];
+        for (unsigned c = 0; c < EQUEUE_CHUNK_CLASSES-1; c++) {
+            // chunks below the last class all have the same size
+            unsigned count = equeue_magazine_cached(m, c);
+            s->chunks[c] += count *
+                    (sizeof(struct equeue_event) + c*sizeof(void*));
+            cached += count;
+        }
+    }
+#endif
+
+    // posted events still in the ingress list are counted once spliced
+    equeue_mutex_lock(&q->queuelock);
+    equeue_ingress_splice(q);
+    s->posts = q->posts;
+    s->dispatches = q->dispatches;
+    s->cancels = q->cancels;
+    s->pending = (unsigned)(q->posts - q->dispatches - q->cancels);
+    s->pending_high = q->pendinghigh;
+    s->spins = q->spins;
+    s->parks = q->parks;
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_mutex_lock(&q->memlock);
+    s->alloc_failures = q->failures;
+    s->slab_used = q->carved;
+    s->slab_remaining = q->slab.size;
+    s->slab_high = q->carvedhigh;
+    size_t free = 0;
+    for (unsigned c = 0; c < EQUEUE_CHUNK_CLASSES; c++) {
+        s->chunks[c] += q->pooled[c];
+        free += s->chunks[c];
+    }
+    s->chunks_used = q->live - cached;
+    s->bytes_used = q->carved - free;
+    equeue_mutex_unlock(&q->memlock);
+}
+
+static bool equeue_requeue(equeue_t *q, int id, equeue_delta_t delay) {
+    if (!id) {
+        return false;
+    }
+
+    equeue_tick_t tick = equeue_tick();
+
+    // decode event from unique id and check that the local id matches
+    equeue_mutex_lock(&q->queuelock);
+    bool pinned = equeue_pin(q, id);
+    struct equeue_event *e = equeue_event_at(q, id);
+    if (!e || e->id != equeue_id_local(q, id)) {
+        equeue_unpin(q, pinned);
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+
+    // events still in the ingress list must reach the wheel first
+    if (!e->ref) {
+        equeue_ingress_splice(q);
+    }
+
+    // in-flight events can no longer be moved
+    if (!e->ref) {
+        equeue_unpin(q, pinned);
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+
+    // move the event in place, keeping its id and memory
+    equeue_wheel_remove(e);
+    e->target = tick + (delay < 0 ? 0 : delay);
+    equeue_schedule(q, e, tick);
+    bool wake = equeue_wake(q, equeue_expiry(e));
+    equeue_unpin(q, pinned);
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (wake) {
+        equeue_signal(q);
+    } else {
+        equeue_busy(q, delay <= 0);
+    }
+
+    return true;
+}
+
+bool equeue_reschedule(equeue_t *q, int id, int ms) {
+    return equeue_requeue(q, id, (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS);
+}
+
+bool equeue_reschedule_us(equeue_t *q, int id, int64_t us) {
+    return equeue_reschedule_ns(q, id, us*1000);
+}
+
+bool equeue_reschedule_ns(equeue_t *q, int id, int64_t ns) {
+    return equeue_requeue(q, id, equeue_nstick(ns));
 }
 
 void equeue_break(equeue_t *q) {
     equeue_mutex_lock(&q->queuelock);
-    q->breaks++;
+    q->breaks++;
+    equeue_mutex_unlock(&q->queuelock);
+    equeue_signal(q);
+}
+
+#ifdef EQUEUE_HISTOGRAMS
+// record ticks in a log-scale histogram
+static void equeue_histogram_record(struct equeue_histogram *h,
+        equeue_delta_t delta) {
+    equeue_tick_t ticks = delta > 0 ? (equeue_tick_t)delta : 0;
+    h->buckets[ticks ? equeue_msb(ticks)+1 : 0] += 1;
+    h->count += 1;
+    if (ticks > h->max) {
+        h->max = ticks;
+    }
+}
+
+// add the records of one histogram to another and clear it
+static void equeue_histogram_fold(struct equeue_histogram *h,
+        struct equeue_histogram *from) {
+    for (unsigned i = 0; i < EQUEUE_HISTOGRAM_BUCKETS; i++) {
+        h->buckets[i] += from->buckets[i];
+    }
+    h->count += from->count;
+    if (from->max > h->max) {
+        h->max = from->max;
+    }
+    memset(from, 0, sizeof(*from));
+}
+#endif
+
+// counters of a batch of events leaving the dispatch loop, these are
+// accumulated without the queuelock and only folded in once per batch
+struct equeue_runs {
+    unsigned dispatched;
+    unsigned skipped;
+#ifdef EQUEUE_HISTOGRAMS
+    struct equeue_histogram lateness;
+    struct equeue_histogram runtime;
+#endif
+};
+
+// count events that have left the dispatch loop, events cancelled while in
+// flight never run and count as cancels, the queuelock must not be held
+static void equeue_count_runs(equeue_t *q, struct equeue_runs *runs) {
+    if (runs->dispatched || runs->skipped) {
+        equeue_mutex_lock(&q->queuelock);
+        q->dispatches += runs->dispatched;
+        q->cancels += runs->skipped;
+#ifdef EQUEUE_HISTOGRAMS
+        if (runs->lateness.count) {
+            equeue_histogram_fold(&q->lateness, &runs->lateness);
+            equeue_histogram_fold(&q->runtime, &runs->runtime);
+        }
+#endif
+        equeue_mutex_unlock(&q->queuelock);
+        runs->dispatched = 0;
+        runs->skipped = 0;
+    }
+}
+
+static void equeue_run(equeue_t *q, struct equeue_event *es) {
+    // hooks are read once for the batch, see equeue_set_hooks
+    struct equeue_hooks hooks = q->hooks;
+
+    // dispatches are counted as callbacks run, but only folded into the
+    // queue's counters once per batch
+    struct equeue_runs runs;
+    memset(&runs, 0, sizeof(runs));
+
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+
+        // callbacks are only timed if something is interested
+        void (*cb)(void *) = e->cb;
+        bool hooked = cb && (hooks.before || hooks.after);
+#ifdef EQUEUE_HISTOGRAMS
+        bool timed = cb;
+#else
+        bool timed = hooked;
+#endif
+        int id = hooked ? equeue_event_id(q, e) : 0;
+        equeue_tick_t start = timed ? equeue_tick() : 0;
+        if (hooked && hooks.before) {
+            hooks.before(hooks.ctx, e + 1, id, cb, start);
+        }
+
+        // actually dispatch the callbacks
+        if (cb) {
+            equeue_trace(q, EQUEUE_TRACE_DISPATCH, equeue_event_id(q, e),
+                    (uint32_t)(uintptr_t)cb);
+            cb(e + 1);
+            equeue_trace(q, EQUEUE_TRACE_DONE, equeue_event_id(q, e),
+                    (uint32_t)(uintptr_t)cb);
+            runs.dispatched += 1;
+        } else {
+            runs.skipped += 1;
+        }
+
+        equeue_tick_t end = timed ? equeue_tick() : 0;
+        if (hooked && hooks.after) {
+            hooks.after(hooks.ctx, e + 1, id, cb, start, end);
+        }
+
+#ifdef EQUEUE_HISTOGRAMS
+        // record how late the callback started and how long it ran
+        if (cb) {
+            equeue_histogram_record(&runs.lateness,
+                    equeue_tickdiff(start, e->target));
+            equeue_histogram_record(&runs.runtime,
+                    equeue_tickdiff(end, start));
+        }
+#endif
+
+#ifdef EQUEUE_EDF
+        // count events that completed after their deadline
+        if (cb && e->deadline >= 0 && equeue_tickdiff(equeue_tick(),
+                e->target + e->deadline) > 0) {
+            equeue_mutex_lock(&q->queuelock);
+            q->misses += 1;
+            equeue_mutex_unlock(&q->queuelock);
+        }
+#endif
+
+        // reenqueue periodic events or deallocate, a period is posted
+        // again so its dispatch must be counted first
+        if (e->period >= 0) {
+            equeue_count_runs(q, &runs);
+            e->target += e->period;
+            equeue_enqueue(q, e, equeue_tick());
+        } else {
+            equeue_incid(q, e);
+            equeue_dealloc(q, e+1);
+        }
+    }
+
+    equeue_count_runs(q, &runs);
+}
+
+#ifdef EQUEUE_FD
+static void equeue_fd_clear(equeue_t *q);
+#endif
+
+#ifdef EQUEUE_REACTOR
+// fd watches, a watch is referenced by its registration and by a posted
+// readiness event, the refs and active flag are protected by the queuelock
+// since another dispatch loop may unwatch the fd
+struct equeue_watch {
+    int fd;
+    uint32_t events;
+    void (*cb)(void *);
+    void *data;
+    equeue_t *q;
+    unsigned refs;
+    bool active;
+};
+
+// drop a reference to a watch, returns true if it was the last
+static bool equeue_watch_release(equeue_t *q, struct equeue_watch *w) {
+    equeue_mutex_lock(&q->queuelock);
+    w->refs -= 1;
+    bool last = !w->refs;
+    equeue_mutex_unlock(&q->queuelock);
+    return last;
+}
+
+// readiness events call the watch's callback and rearm the watch, the
+// watch uses EPOLLONESHOT so it is never posted twice
+static void equeue_watch_dispatch(void *p) {
+    struct equeue_watch *w = *(struct equeue_watch **)p;
+    equeue_t *q = w->q;
+
+    equeue_mutex_lock(&q->queuelock);
+    bool active = w->active;
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (active) {
+        w->cb(w->data);
+    }
+
+    // the callback may have unwatched the fd, rearming under the lock
+    // keeps a concurrent unwatch from racing with the rearm
+    equeue_mutex_lock(&q->queuelock);
+    if (w->active) {
+        struct epoll_event ev = {.events = w->events | EPOLLONESHOT};
+        ev.data.ptr = w;
+        epoll_ctl(q->reactor.epoll, EPOLL_CTL_MOD, w->fd, &ev);
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (equeue_watch_release(q, w)) {
+        equeue_dealloc(q, w);
+    }
+}
+
+// sleep in epoll_wait until a watched fd is ready, the semaphore is
+// signalled, or the timeout passes, ready fds are posted as events
+#define EQUEUE_REACTOR_EVENTS 16
+
+static void equeue_reactor_wait(equeue_t *q, equeue_delta_t deadline) {
+    if (__atomic_load_n(&q->reactor.epoll, __ATOMIC_ACQUIRE) < 0) {
+        equeue_sema_wait(&q->eventsema, deadline);
+        return;
+    }
+
+    // any signal also writes the eventfd, so a signal that races with
+    // the check still wakes up epoll_wait
+    if (equeue_sema_wait(&q->eventsema, 0)) {
+        return;
+    }
+
+    struct epoll_event evs[EQUEUE_REACTOR_EVENTS];
+    int n = epoll_wait(q->reactor.epoll, evs, EQUEUE_REACTOR_EVENTS,
+            deadline < 0 ? -1 : equeue_tickms(deadline));
+
+    // this dispatch loop is already awake to run the readiness events, so
+    // mark it as no longer sleeping to keep posting them from signalling it
+    if (n > 0) {
+        equeue_mutex_lock(&q->queuelock);
+        equeue_sleep(q, q->sleepers > 1, q->wakeup);
+        for (int i = 0; i < n; i++) {
+            struct equeue_watch *w = evs[i].data.ptr;
+            if (w) {
+                w->refs += 1;
+            }
+        }
+        equeue_mutex_unlock(&q->queuelock);
+    }
+
+    for (int i = 0; i < n; i++) {
+        struct equeue_watch *w = evs[i].data.ptr;
+        if (!w) {
+            uint64_t count;
+            ssize_t res = read(q->reactor.event, &count, sizeof(count));
+            (void)res;
+            continue;
+        }
+
+        struct equeue_watch **e = equeue_alloc(q,
+                sizeof(struct equeue_watch *));
+        if (e) {
+            *e = w;
+            equeue_post(q, equeue_watch_dispatch, e);
+        } else {
+            // rearm so the readiness is reported again
+            equeue_watch_release(q, w);
+            struct epoll_event ev = {.events = w->events | EPOLLONESHOT};
+            ev.data.ptr = w;
+            epoll_ctl(q->reactor.epoll, EPOLL_CTL_MOD, w->fd, &ev);
+        }
+    }
+
+    equeue_sema_wait(&q->eventsema, 0);
+}
+
+// create the epoll instance on the first watch, the dispatch loop is
+// signalled so it moves from its semaphore into epoll_wait
+static int equeue_reactor_create(equeue_t *q) {
+    equeue_mutex_lock(&q->queuelock);
+    if (q->reactor.epoll >= 0) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    int event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event ev = {.events = EPOLLIN};
+    ev.data.ptr = 0;
+    if (epoll < 0 || event < 0 ||
+            epoll_ctl(epoll, EPOLL_CTL_ADD, event, &ev)) {
+        int err = -errno;
+        if (epoll >= 0) {
+            close(epoll);
+        }
+        if (event >= 0) {
+            close(event);
+        }
+        equeue_mutex_unlock(&q->queuelock);
+        return err;
+    }
+
+    q->reactor.event = event;
+    __atomic_store_n(&q->reactor.epoll, epoll, __ATOMIC_RELEASE);
     equeue_mutex_unlock(&q->queuelock);
+
     equeue_sema_signal(&q->eventsema);
+    return 0;
+}
+
+struct equeue_watch *equeue_watch_fd(equeue_t *q, int fd,
+        uint32_t events, void (*cb)(void *), void *data) {
+    if (equeue_reactor_create(q)) {
+        return 0;
+    }
+
+    struct equeue_watch *w = equeue_alloc(q, sizeof(struct equeue_watch));
+    if (!w) {
+        return 0;
+    }
+
+    w->fd = fd;
+    w->events = events;
+    w->cb = cb;
+    w->data = data;
+    w->q = q;
+    w->refs = 1;
+    w->active = true;
+
+    struct epoll_event ev = {.events = events | EPOLLONESHOT};
+    ev.data.ptr = w;
+    if (epoll_ctl(q->reactor.epoll, EPOLL_CTL_ADD, fd, &ev)) {
+        equeue_dealloc(q, w);
+        return 0;
+    }
+
+    return w;
+}
+
+void equeue_unwatch_fd(equeue_t *q, struct equeue_watch *w) {
+    equeue_mutex_lock(&q->queuelock);
+    epoll_ctl(q->reactor.epoll, EPOLL_CTL_DEL, w->fd, 0);
+    w->active = false;
+    equeue_mutex_unlock(&q->queuelock);
+
+    // a posted readiness event frees the watch once it is dispatched
+    if (equeue_watch_release(q, w)) {
+        equeue_dealloc(q, w);
+    }
+}
+#endif
+
+#if defined(__GNUC__)
+// spin instead of parking until a close deadline, posts that need the
+// dispatch loop clear the sleeping flag and breaks are counted before
+// signalling, so both can be polled without touching the semaphore
+#define EQUEUE_SPIN_POLLS 16
+
+static void equeue_spin(equeue_t *q, equeue_tick_t tick,
+        equeue_delta_t deadline) {
+    while (equeue_tickdiff(equeue_tick(), tick) < deadline) {
+        for (int i = 0; i < EQUEUE_SPIN_POLLS; i++) {
+            if (!__atomic_load_n(&q->sleeping, __ATOMIC_ACQUIRE) ||
+                __atomic_load_n(&q->breaks, __ATOMIC_ACQUIRE)) {
+                equeue_sema_wait(&q->eventsema, 0);
+                return;
+            }
+            equeue_cpu_relax();
+        }
+    }
 }
+#endif
 
 void equeue_dispatch(equeue_t *q, int ms) {
-    unsigned tick = equeue_tick();
-    unsigned timeout = tick + ms;
-    q->background.active = false;
+    equeue_tick_t tick = equeue_tick();
+    equeue_tick_t timeout = tick + (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS;
+    equeue_activate(q, false);
+#ifdef EQUEUE_FD
+    equeue_fd_clear(q);
+#endif
+
+    equeue_mutex_lock(&q->queuelock);
+    q->dispatchers += 1;
+    equeue_mutex_unlock(&q->queuelock);
 
     while (1) {
         // collect all the available events and next deadline
         struct equeue_event *es = equeue_dequeue(q, tick);
 
         // dispatch events
-        while (es) {
-            struct equeue_event *e = es;
-            es = e->next;
-
-            // actually dispatch the callbacks
-            void (*cb)(void *) = e->cb;
-            if (cb) {
-                cb(e + 1);
-            }
-
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                equeue_incid(q, e);
-                equeue_dealloc(q, e+1);
-            }
-        }
+        equeue_run(q, es);
 
-        int deadline = -1;
+        equeue_delta_t deadline = -1;
         tick = equeue_tick();
 
         // check if we should stop dispatching soon
         if (ms >= 0) {
             deadline = equeue_tickdiff(timeout, tick);
             if (deadline <= 0) {
+                equeue_mutex_lock(&q->queuelock);
+                q->dispatchers -= 1;
+
                 // update background timer if necessary
                 if (q->background.update) {
-                    equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
-                        q->background.update(q->background.timer,
-                                equeue_clampdiff(q->queue->target, tick));
+                    equeue_ingress_splice(q);
+                    equeue_tick_t target;
+                    if (q->readymap) {
+                        equeue_background_update(q, 0);
+                    } else if (equeue_wheel_peek(q, &target, true)) {
+                        equeue_background_update(q,
+                                equeue_clampdiff(target, tick));
                     }
-                    q->background.active = true;
-                    equeue_mutex_unlock(&q->queuelock);
+                    equeue_activate(q, true);
                 }
+                equeue_mutex_unlock(&q->queuelock);
                 return;
             }
         }
 
-        // find closest deadline
+        // find closest deadline, waking up early to cascade the wheel is
+        // cheaper than finding the exact target
+        //
+        // posts are signalled until the deadline is known, a negative
+        // deadline waits for the furthest representable tick, events left
+        // over by other dispatchers are picked up without sleeping
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
-            if ((unsigned)diff < (unsigned)deadline) {
-                deadline = diff;
+        bool sleep = !q->readymap;
+        equeue_delta_t budget = q->spin;
+        equeue_delta_t window = q->spinwindow;
+        if (sleep) {
+            q->sleepers += 1;
+            equeue_sleep(q, true, tick + ((equeue_tick_t)-1 >> 1));
+            equeue_ingress_splice(q);
+
+            equeue_tick_t target;
+            if (equeue_wheel_peek(q, &target, false)) {
+                equeue_delta_t diff = equeue_clampdiff(target, tick);
+                if ((equeue_tick_t)diff < (equeue_tick_t)deadline) {
+                    deadline = diff;
+                }
+            }
+
+            if (deadline >= 0) {
+                equeue_sleep_store(&q->wakeup, tick + deadline);
             }
         }
         equeue_mutex_unlock(&q->queuelock);
 
-        // wait for events
-        equeue_sema_wait(&q->eventsema, deadline);
+#ifdef EQUEUE_SLABS
+        // return idle overflow slabs before going to sleep
+        if (sleep) {
+            equeue_slab_trim(q);
+        }
+#endif
+
+        // wait for events, deadlines within the spin window are spun for
+        // instead of parking, anything further away parks right away
+        bool spun = false;
+        if (sleep) {
+            equeue_trace(q, EQUEUE_TRACE_SLEEP, 0,
+                    deadline < 0 ? -1 : equeue_tickms(deadline));
+#if defined(__GNUC__)
+            spun = budget > 0 && deadline >= 0 && deadline <= window;
+            if (spun) {
+                equeue_spin(q, tick, deadline);
+            }
+#endif
+            if (!spun) {
+#ifdef EQUEUE_REACTOR
+                equeue_reactor_wait(q, deadline);
+#else
+                equeue_sema_wait(&q->eventsema, deadline);
+#endif
+            }
+            equeue_trace(q, EQUEUE_TRACE_WAKE, 0, 0);
+        }
+        equeue_delta_t slept = sleep && budget > 0
+                ? equeue_tickdiff(equeue_tick(), tick) : 0;
 
-        // check if we were notified to break out of dispatch
-        if (q->breaks) {
+        // rearm wakeups for any other sleeping dispatchers and check if
+        // we were notified to break out of dispatch
+        if (sleep || q->breaks) {
             equeue_mutex_lock(&q->queuelock);
+            if (sleep) {
+                q->sleepers -= 1;
+                equeue_sleep(q, q->sleepers > 0, q->wakeup);
+
+                // adapt the spin window to how sleeps end, parks that
+                // barely outlast the budget restore it, longer parks
+                // halve it
+                if (spun) {
+                    q->spins += 1;
+                    q->spinwindow = q->spin;
+                } else {
+                    q->parks += 1;
+                    q->spinwindow = slept <= 2*q->spin ? q->spin : window/2;
+                }
+            }
+
             if (q->breaks > 0) {
                 q->breaks--;
+                q->dispatchers -= 1;
+
+                // signals may merge, so pass remaining breaks on
+                bool wake = q->breaks > 0 && q->sleepers > 0;
                 equeue_mutex_unlock(&q->queuelock);
+                if (wake) {
+                    equeue_signal(q);
+                }
                 return;
             }
             equeue_mutex_unlock(&q->queuelock);
@@ -440,16 +2607,82 @@ void equeue_dispatch(equeue_t *q, int ms) {
     }
 }
 
+bool equeue_steal(equeue_t *q) {
+    equeue_tick_t tick = equeue_tick();
+
+    // only steal from queues where every dispatcher is busy, joining as
+    // another dispatcher hands out expired events one at a time
+    equeue_mutex_lock(&q->queuelock);
+    if (!q->dispatchers || q->sleepers) {
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+    q->dispatchers += 1;
+    equeue_mutex_unlock(&q->queuelock);
+
+    struct equeue_event *es = equeue_dequeue(q, tick);
+    equeue_run(q, es);
+
+    equeue_mutex_lock(&q->queuelock);
+    q->dispatchers -= 1;
+    equeue_mutex_unlock(&q->queuelock);
+
+    return es != 0;
+}
+
 
 // event functions
 void equeue_event_delay(void *p, int ms) {
     struct equeue_event *e = (struct equeue_event*)p - 1;
-    e->target = ms;
+    e->target = (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS;
+}
+
+void equeue_event_delay_us(void *p, int64_t us) {
+    equeue_event_delay_ns(p, us*1000);
+}
+
+void equeue_event_delay_ns(void *p, int64_t ns) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->target = equeue_nstick(ns);
 }
 
 void equeue_event_period(void *p, int ms) {
     struct equeue_event *e = (struct equeue_event*)p - 1;
-    e->period = ms;
+    e->period = (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS;
+}
+
+void equeue_event_period_us(void *p, int64_t us) {
+    equeue_event_period_ns(p, us*1000);
+}
+
+void equeue_event_period_ns(void *p, int64_t ns) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->period = equeue_nstick(ns);
+}
+
+void equeue_event_slack(void *p, int ms) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->slack = (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS;
+}
+
+void equeue_event_slack_us(void *p, int64_t us) {
+    equeue_event_slack_ns(p, us*1000);
+}
+
+void equeue_event_slack_ns(void *p, int64_t ns) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->slack = equeue_nstick(ns);
+}
+
+void equeue_event_priority(void *p, int priority) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    if (priority < 0) {
+        priority = 0;
+    } else if (priority > EQUEUE_PRIORITIES-1) {
+        priority = EQUEUE_PRIORITIES-1;
+    }
+
+    e->priority = priority;
 }
 
 void equeue_event_dtor(void *p, void (*dtor)(void *)) {
@@ -457,6 +2690,78 @@ void equeue_event_dtor(void *p, void (*dtor)(void *)) {
     e->dtor = dtor;
 }
 
+#ifdef EQUEUE_EDF
+void equeue_event_deadline(void *p, int ms) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->deadline = (equeue_delta_t)ms*EQUEUE_TICKS_PER_MS;
+}
+
+void equeue_event_deadline_us(void *p, int64_t us) {
+    equeue_event_deadline_ns(p, us*1000);
+}
+
+void equeue_event_deadline_ns(void *p, int64_t ns) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    e->deadline = equeue_nstick(ns);
+}
+
+unsigned equeue_deadline_misses(equeue_t *q) {
+    equeue_mutex_lock(&q->queuelock);
+    unsigned misses = q->misses;
+    equeue_mutex_unlock(&q->queuelock);
+    return misses;
+}
+#endif
+
+#ifdef EQUEUE_HISTOGRAMS
+void equeue_histograms(equeue_t *q,
+        struct equeue_histogram *lateness, struct equeue_histogram *runtime) {
+    equeue_mutex_lock(&q->queuelock);
+    if (lateness) {
+        *lateness = q->lateness;
+    }
+    if (runtime) {
+        *runtime = q->runtime;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+void equeue_histograms_reset(equeue_t *q) {
+    equeue_mutex_lock(&q->queuelock);
+    memset(&q->lateness, 0, sizeof(q->lateness));
+    memset(&q->runtime, 0, sizeof(q->runtime));
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+equeue_tick_t equeue_histogram_percentile(
+        const struct equeue_histogram *h, unsigned percentile) {
+    if (!h->count) {
+        return 0;
+    }
+
+    // find the bucket holding the nth smallest value, rounding up
+    if (percentile > 100) {
+        percentile = 100;
+    }
+    uint64_t rank = (h->count*percentile + 99) / 100;
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < EQUEUE_HISTOGRAM_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            // bucket i holds values up to 2^i - 1
+            equeue_tick_t bound = i ? ((equeue_tick_t)1 << (i-1) << 1) - 1 : 0;
+            return bound < h->max ? bound : h->max;
+        }
+    }
+
+    return h->max;
+}
+#endif
+
 
 // simple callbacks 
 struct ecallback {
@@ -492,6 +2797,24 @@ int equeue_call_in(equeue_t *q, int ms, void (*cb)(void*), void *data) {
     return equeue_post(q, ecallback_dispatch, e);
 }
 
+int equeue_call_in_us(equeue_t *q, int64_t us,
+        void (*cb)(void*), void *data) {
+    return equeue_call_in_ns(q, us*1000, cb, data);
+}
+
+int equeue_call_in_ns(equeue_t *q, int64_t ns,
+        void (*cb)(void*), void *data) {
+    struct ecallback *e = equeue_alloc(q, sizeof(struct ecallback));
+    if (!e) {
+        return 0;
+    }
+
+    equeue_event_delay_ns(e, ns);
+    e->cb = cb;
+    e->data = data;
+    return equeue_post(q, ecallback_dispatch, e);
+}
+
 int equeue_call_every(equeue_t *q, int ms, void (*cb)(void*), void *data) {
     struct ecallback *e = equeue_alloc(q, sizeof(struct ecallback));
     if (!e) {
@@ -505,6 +2828,45 @@ int equeue_call_every(equeue_t *q, int ms, void (*cb)(void*), void *data) {
     return equeue_post(q, ecallback_dispatch, e);
 }
 
+int equeue_call_every_us(equeue_t *q, int64_t us,
+        void (*cb)(void*), void *data) {
+    return equeue_call_every_ns(q, us*1000, cb, data);
+}
+
+int equeue_call_every_ns(equeue_t *q, int64_t ns,
+        void (*cb)(void*), void *data) {
+    struct ecallback *e = equeue_alloc(q, sizeof(struct ecallback));
+    if (!e) {
+        return 0;
+    }
+
+    equeue_event_delay_ns(e, ns);
+    equeue_event_period_ns(e, ns);
+    e->cb = cb;
+    e->data = data;
+    return equeue_post(q, ecallback_dispatch, e);
+}
+
+// setup each event of a call batch with the shared callback and its data
+struct ecallback_batch {
+    void (*cb)(void*);
+    void **data;
+};
+
+static void ecallback_batch_init(void *p, int i, void *data) {
+    struct ecallback *e = (struct ecallback*)p;
+    struct ecallback_batch *batch = (struct ecallback_batch*)data;
+    e->cb = batch->cb;
+    e->data = batch->data[i];
+}
+
+int equeue_call_batch(equeue_t *q, void (*cb)(void*),
+        void **data, int *ids, int count) {
+    struct ecallback_batch batch = {cb, data};
+    return equeue_emplace_batch(q, sizeof(struct ecallback),
+            ecallback_dispatch, ecallback_batch_init, &batch, ids, count);
+}
+
 
 // backgrounding
 void equeue_background(equeue_t *q,
@@ -516,14 +2878,252 @@ void equeue_background(equeue_t *q,
 
     q->background.update = update;
     q->background.timer = timer;
+    equeue_ingress_splice(q);
+
+    equeue_tick_t target;
+    if (q->background.update && equeue_wheel_peek(q, &target, true)) {
+        equeue_background_update(q,
+                equeue_clampdiff(target, equeue_tick()));
+    }
+    equeue_activate(q, q->background.update != 0);
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+#ifdef EQUEUE_TRACE
+unsigned equeue_trace_dump(equeue_t *q,
+        struct equeue_trace_record *records, unsigned count) {
+    uint32_t head = __atomic_load_n(&q->tracehead, __ATOMIC_ACQUIRE);
+    uint32_t n = head < EQUEUE_TRACE ? head : EQUEUE_TRACE;
+    if (n > count) {
+        n = count;
+    }
+
+    // copy each record and check that its sequence number did not change
+    // while it was being copied
+    unsigned copied = 0;
+    for (uint32_t seq = head - n; seq != head; seq++) {
+        struct equeue_trace_record *r = &q->trace[seq & (EQUEUE_TRACE-1)];
+        if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != seq+1) {
+            continue;
+        }
+
+        records[copied] = *r;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&r->seq, __ATOMIC_RELAXED) != seq+1) {
+            continue;
+        }
+
+        records[copied].seq = seq+1;
+        copied += 1;
+    }
+
+    return copied;
+}
+#endif
+
+void equeue_set_spin_ns(equeue_t *q, int64_t ns) {
+    equeue_delta_t spin = ns > 0 ? equeue_nstick(ns) : 0;
+
+    equeue_mutex_lock(&q->queuelock);
+    q->spin = spin;
+    q->spinwindow = spin;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+void equeue_set_busy_hook(equeue_t *q, void (*hook)(void *ctx), void *ctx) {
+    equeue_mutex_lock(&q->queuelock);
+    q->busy.hook = hook;
+    q->busy.ctx = ctx;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+void equeue_set_hooks(equeue_t *q,
+        void (*before)(void *ctx, void *event, int id,
+            void (*cb)(void *), equeue_tick_t start),
+        void (*after)(void *ctx, void *event, int id,
+            void (*cb)(void *), equeue_tick_t start, equeue_tick_t end),
+        void *ctx) {
+    equeue_mutex_lock(&q->queuelock);
+    q->hooks.before = before;
+    q->hooks.after = after;
+    q->hooks.ctx = ctx;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+#ifdef EQUEUE_FD
+// readiness is cleared when dispatching starts, the background timer is
+// inactive so anything posted afterwards is caught when dispatch ends
+static void equeue_fd_clear(equeue_t *q) {
+    if (q->fds.epoll < 0) {
+        return;
+    }
+
+    uint64_t count;
+    ssize_t res = read(q->fds.event, &count, sizeof(count));
+    (void)res;
+
+    struct itimerspec its = {{0, 0}, {0, 0}};
+    timerfd_settime(q->fds.timer, 0, &its, 0);
+}
+
+static void equeue_fd_update(void *p, int ms) {
+    equeue_t *q = (equeue_t *)p;
+
+    // arming or disarming the timer also clears its expirations
+    struct itimerspec its = {{0, 0}, {0, 0}};
+    if (ms > 0) {
+        its.it_value.tv_sec = ms / 1000;
+        its.it_value.tv_nsec = (ms % 1000) * 1000000;
+    }
+    timerfd_settime(q->fds.timer, 0, &its, 0);
+
+    if (ms == 0) {
+        uint64_t count = 1;
+        ssize_t res = write(q->fds.event, &count, sizeof(count));
+        (void)res;
+    }
+}
+
+int equeue_fd(equeue_t *q) {
+    if (q->fds.epoll >= 0) {
+        return q->fds.epoll;
+    }
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    int event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    int err = (epoll < 0 || event < 0 || timer < 0) ? -errno : 0;
+
+    struct epoll_event ev = {.events = EPOLLIN};
+    if (!err) {
+        ev.data.fd = event;
+        err = epoll_ctl(epoll, EPOLL_CTL_ADD, event, &ev) ? -errno : 0;
+    }
+    if (!err) {
+        ev.data.fd = timer;
+        err = epoll_ctl(epoll, EPOLL_CTL_ADD, timer, &ev) ? -errno : 0;
+    }
+
+    if (err) {
+        if (epoll >= 0) {
+            close(epoll);
+        }
+        if (event >= 0) {
+            close(event);
+        }
+        if (timer >= 0) {
+            close(timer);
+        }
+        return err;
+    }
+
+    q->fds.epoll = epoll;
+    q->fds.event = event;
+    q->fds.timer = timer;
+    equeue_background(q, equeue_fd_update, q);
+    return epoll;
+}
+#endif
+
+#ifdef EQUEUE_TIMERFD
+// the timerfd thread dispatches the queue each time the timerfd expires,
+// the timerfd is blocking so the thread sleeps in read
+static void *equeue_timerfd_thread(void *p) {
+    equeue_t *q = (equeue_t *)p;
+
+    while (true) {
+        uint64_t count;
+        if (read(q->timerfd.fd, &count, sizeof(count)) < 0 &&
+                errno != EINTR) {
+            break;
+        }
+
+        if (__atomic_load_n(&q->timerfd.stop, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        equeue_dispatch(q, 0);
+    }
+
+    return 0;
+}
+
+// timerfds are disarmed by a zero expiration, so immediate dispatches and
+// stopping the thread use the shortest possible expiration instead
+static void equeue_timerfd_update(void *p, int ms) {
+    equeue_t *q = (equeue_t *)p;
+    equeue_delta_t delta = q->background.delta;
+
+    struct itimerspec its = {{0, 0}, {0, 1}};
+    if (ms < 0) {
+        __atomic_store_n(&q->timerfd.stop, true, __ATOMIC_RELEASE);
+    } else if (delta > 0) {
+#if defined(EQUEUE_HIGHRES)
+        its.it_value.tv_sec = delta / 1000000000;
+        its.it_value.tv_nsec = delta % 1000000000;
+#else
+        its.it_value.tv_sec = delta / 1000;
+        its.it_value.tv_nsec = (delta % 1000) * 1000000;
+#endif
+    }
+    timerfd_settime(q->timerfd.fd, 0, &its, 0);
+}
 
-    if (q->background.update && q->queue) {
-        q->background.update(q->background.timer,
-                equeue_clampdiff(q->queue->target, equeue_tick()));
+// stop and join the timerfd thread, this must not be called with the
+// queuelock held since the thread may be dispatching
+static void equeue_timerfd_stop(equeue_t *q) {
+    if (!q->timerfd.running) {
+        return;
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    if (q->background.update == equeue_timerfd_update) {
+        q->background.update = 0;
+        equeue_activate(q, false);
     }
-    q->background.active = true;
+    __atomic_store_n(&q->timerfd.stop, true, __ATOMIC_RELEASE);
+    struct itimerspec its = {{0, 0}, {0, 1}};
+    timerfd_settime(q->timerfd.fd, 0, &its, 0);
     equeue_mutex_unlock(&q->queuelock);
+
+    pthread_join(q->timerfd.thread, 0);
+    q->timerfd.running = false;
+}
+
+int equeue_background_timerfd(equeue_t *q) {
+    if (q->timerfd.running) {
+        equeue_mutex_lock(&q->queuelock);
+        bool current = q->background.update == equeue_timerfd_update;
+        equeue_mutex_unlock(&q->queuelock);
+        if (current) {
+            return 0;
+        }
+
+        // the background timer was replaced, reap the old thread
+        equeue_timerfd_stop(q);
+    }
+
+    if (q->timerfd.fd < 0) {
+        q->timerfd.fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (q->timerfd.fd < 0) {
+            return -errno;
+        }
+    }
+
+    struct itimerspec its = {{0, 0}, {0, 0}};
+    timerfd_settime(q->timerfd.fd, 0, &its, 0);
+    q->timerfd.stop = false;
+
+    int err = pthread_create(&q->timerfd.thread, 0, equeue_timerfd_thread, q);
+    if (err) {
+        return -err;
+    }
+
+    q->timerfd.running = true;
+    equeue_background(q, equeue_timerfd_update, q);
+    return 0;
 }
+#endif
 
 struct equeue_chain_context {
     equeue_t *q;
@@ -16,51 +16,370 @@ extern "C" {
 
 #include <stddef.h>
 #include <stdint.h>
+#ifdef EQUEUE_TIMERFD
+#include <pthread.h>
+#endif
 
 
 // The minimum size of an event
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// Timing wheel configuration
+//
+// Pending events are stored in a hierarchical timing wheel, where each level
+// resolves EQUEUE_WHEEL_BITS bits of an event's target tick. Enough levels
+// are provided to cover the full EQUEUE_TICK_BITS-bit tick. Larger values
+// trade memory in the equeue_t structure for fewer cascades between levels.
+#ifndef EQUEUE_WHEEL_BITS
+#define EQUEUE_WHEEL_BITS 4
+#endif
+#define EQUEUE_WHEEL_SLOTS (1 << EQUEUE_WHEEL_BITS)
+#define EQUEUE_WHEEL_LEVELS \
+    ((EQUEUE_TICK_BITS+EQUEUE_WHEEL_BITS-1) / EQUEUE_WHEEL_BITS)
+
+#if EQUEUE_WHEEL_BITS < 1 || EQUEUE_WHEEL_BITS > 5
+#error "EQUEUE_WHEEL_BITS must be between 1 and 5"
+#endif
+
+// Allocator configuration
+//
+// Freed events are kept in segregated lists by size, one for each word of
+// event data up to EQUEUE_CHUNK_CLASSES-1 words. The last class holds all
+// larger events in a list sorted by size.
+//
+// Only events up to EQUEUE_CHUNK_CLASSES-1 words of data are allocated and
+// freed in constant time regardless of how many sizes are in use. Events
+// in the last class walk its sorted list, so their cost grows with the
+// number of different large sizes that are free. Raise
+// EQUEUE_CHUNK_CLASSES to cover the largest event an application posts
+// from latency sensitive contexts.
+#ifndef EQUEUE_CHUNK_CLASSES
+#define EQUEUE_CHUNK_CLASSES 16
+#endif
+
+#if EQUEUE_CHUNK_CLASSES < 1 || EQUEUE_CHUNK_CLASSES > 32
+#error "EQUEUE_CHUNK_CLASSES must be between 1 and 32"
+#endif
+
+// Per-thread allocation caches
+//
+// Define EQUEUE_MAGAZINES to the number of magazines that cache freed chunks
+// of each size class. Each magazine is claimed by the first thread to
+// allocate or free through it and is then only used by that thread, so
+// steady-state allocations take no lock and touch no cache line shared
+// with other threads. Magazines refill from and flush to the shared
+// chunks in batches of EQUEUE_MAGAZINE_BATCH.
+//
+// Magazines are not released when their thread exits, threads beyond the
+// first EQUEUE_MAGAZINES use the shared chunks under the memlock. Requires
+// support for __thread variables and __atomic builtins.
+//#define EQUEUE_MAGAZINES 8
+#ifdef EQUEUE_MAGAZINES
+#ifndef EQUEUE_MAGAZINE_BATCH
+#define EQUEUE_MAGAZINE_BATCH 8
+#endif
+
+#ifndef EQUEUE_CACHE_LINE
+#define EQUEUE_CACHE_LINE 64
+#endif
+
+#if EQUEUE_CHUNK_CLASSES < 2
+#error "EQUEUE_MAGAZINES requires at least 2 EQUEUE_CHUNK_CLASSES"
+#endif
+
+#if EQUEUE_MAGAZINE_BATCH < 1
+#error "EQUEUE_MAGAZINE_BATCH must be at least 1"
+#endif
+#endif
+
+// Coalescing allocator
+//
+// Define EQUEUE_COALESCE to split larger free chunks when allocating smaller
+// events and to merge neighbouring free chunks when an allocation would
+// otherwise fail, so a buffer carved into small events can still satisfy
+// larger events later. A bitmap of chunk boundaries is kept at the end of
+// each buffer, costing one bit per word, so ids of merged events are still
+// safely rejected.
+//#define EQUEUE_COALESCE
+
+// Growable event memory
+//
+// Define EQUEUE_SLABS to the number of overflow slabs an event queue may
+// allocate with malloc once its buffer is exhausted. Each overflow slab is
+// the size of the original buffer, and overflow slabs without allocated
+// events are freed by the dispatch loop before it goes to sleep. Growing
+// calls malloc, so equeue_alloc is only irq safe while the queue does not
+// need to grow.
+//#define EQUEUE_SLABS 4
+#ifdef EQUEUE_SLABS
+#if EQUEUE_SLABS < 1 || EQUEUE_SLABS > 15
+#error "EQUEUE_SLABS must be between 1 and 15"
+#endif
+
+// bits needed to encode a slab index in an event's unique id
+#define EQUEUE_SLAB_BITS \
+    (EQUEUE_SLABS < 2 ? 1 : EQUEUE_SLABS < 4 ? 2 : EQUEUE_SLABS < 8 ? 3 : 4)
+#endif
+
+// Priority levels
+//
+// Expired events are kept in one ready list for each priority level, and
+// higher priority events are always dispatched first. Events at the same
+// priority are dispatched in order of their targets and then in the order
+// they were posted.
+#ifndef EQUEUE_PRIORITIES
+#define EQUEUE_PRIORITIES 4
+#endif
+
+#if EQUEUE_PRIORITIES < 1 || EQUEUE_PRIORITIES > 32
+#error "EQUEUE_PRIORITIES must be between 1 and 32"
+#endif
+
+// Earliest-deadline-first dispatch
+//
+// Define EQUEUE_EDF to give events a completion deadline relative to their
+// target. Expired events with deadlines are dispatched in order of their
+// deadlines, ahead of events without deadlines at the same priority, and
+// events that complete after their deadline are counted as misses.
+//#define EQUEUE_EDF
+
+// Dispatch latency histograms
+//
+// Define EQUEUE_HISTOGRAMS to record how late each callback starts after
+// its target and how long it runs. Both are kept in log-scale histograms
+// of ticks, see equeue_histograms. Without it the dispatch loop is not
+// instrumented at all.
+//#define EQUEUE_HISTOGRAMS
+
+// Pollable file descriptor
+//
+// Define EQUEUE_FD to let an event queue be serviced from an existing
+// epoll, poll or select loop through equeue_fd. Requires Linux.
+//#define EQUEUE_FD
+
+// Fd readiness reactor
+//
+// Define EQUEUE_REACTOR to let an event queue dispatch callbacks when file
+// descriptors become ready, see equeue_watch_fd. Once any descriptor is
+// watched, the dispatch loop sleeps in epoll_wait instead of on its
+// semaphore. Requires Linux.
+//#define EQUEUE_REACTOR
+
+// Timerfd background driver
+//
+// Define EQUEUE_TIMERFD to provide equeue_background_timerfd, which
+// dispatches an event queue from a thread sleeping on a Linux timerfd.
+// With EQUEUE_HIGHRES the timerfd is armed to the nanosecond.
+//#define EQUEUE_TIMERFD
+
+// Event tracing
+//
+// Define EQUEUE_TRACE to the number of records, a power of two, kept in
+// a per-queue ring buffer of trace records. Posts, wheel inserts, expiry,
+// dispatches, cancels, allocation failures and the dispatch loop sleeping
+// and waking are recorded without taking any locks, see equeue_trace_dump.
+// Requires GCC-style __atomic builtins and __thread.
+//#define EQUEUE_TRACE 256
+#ifdef EQUEUE_TRACE
+#if EQUEUE_TRACE < 1 || (EQUEUE_TRACE & (EQUEUE_TRACE-1))
+#error "EQUEUE_TRACE must be a power of two"
+#endif
+#endif
+
+// Trace record types
+enum equeue_trace_type {
+    EQUEUE_TRACE_POST       = 1, // event posted, arg is the callback
+    EQUEUE_TRACE_ENQUEUE    = 2, // event put in the wheel, arg is the delay
+    EQUEUE_TRACE_DEQUEUE    = 3, // event made ready, arg is the priority
+    EQUEUE_TRACE_DISPATCH   = 4, // callback started, arg is the callback
+    EQUEUE_TRACE_DONE       = 5, // callback returned, arg is the callback
+    EQUEUE_TRACE_CANCEL     = 6, // event cancelled
+    EQUEUE_TRACE_ALLOCFAIL  = 7, // allocation failed, arg is the size
+    EQUEUE_TRACE_SLEEP      = 8, // dispatch loop sleeping, arg is the timeout
+    EQUEUE_TRACE_WAKE       = 9, // dispatch loop woken
+};
+
+// Trace record, a dump is a sequence of these in host byte order
+struct equeue_trace_record {
+    uint64_t time;      // nanoseconds since an arbitrary point
+    uint32_t seq;       // sequence number, starting from 1
+    uint32_t queue;     // identifies the queue
+    uint32_t thread;    // identifies the thread
+    int32_t id;         // event's unique id, or 0
+    uint32_t arg;       // depends on the type, times are in milliseconds
+    uint8_t type;
+    uint8_t reserved[3];
+};
+
+// Lock-free ingress
+//
+// Define EQUEUE_INGRESS to have equeue_post push events onto a lock-free
+// list instead of taking the queue's lock. The dispatch loop splices this
+// list into the timing wheel, so producers on other threads no longer
+// contend on the queue's lock. Requires GCC-style __atomic builtins.
+//#define EQUEUE_INGRESS
+
 // Internal event structure
 struct equeue_event {
     unsigned size;
     uint8_t id;
-    uint8_t generation;
+    uint8_t priority;
+#ifdef EQUEUE_SLABS
+    uint8_t slab;
+#endif
+#ifdef EQUEUE_COALESCE
+    uint8_t pooled;
+#endif
 
     struct equeue_event *next;
     struct equeue_event *sibling;
     struct equeue_event **ref;
 
-    unsigned target;
-    int period;
+    equeue_tick_t target;
+    equeue_delta_t period;
+    equeue_delta_t slack;
+#ifdef EQUEUE_EDF
+    equeue_delta_t deadline;
+#endif
     void (*dtor)(void *);
 
     void (*cb)(void *);
     // data follows
 };
 
+#ifdef EQUEUE_HISTOGRAMS
+// Log-scale histogram of ticks, bucket 0 counts zero ticks and bucket i
+// counts ticks in the range [2^(i-1), 2^i)
+#define EQUEUE_HISTOGRAM_BUCKETS (EQUEUE_TICK_BITS+1)
+
+struct equeue_histogram {
+    uint64_t count;
+    equeue_tick_t max;
+    uint32_t buckets[EQUEUE_HISTOGRAM_BUCKETS];
+};
+#endif
+
 // Event queue structure
 typedef struct equeue {
-    struct equeue_event *queue;
-    unsigned tick;
+    struct equeue_wheel {
+        uint32_t map[EQUEUE_WHEEL_LEVELS];
+        struct equeue_event *slots[EQUEUE_WHEEL_LEVELS][EQUEUE_WHEEL_SLOTS];
+    } wheel;
+    equeue_tick_t tick;
+    uint32_t readymap;
+    struct equeue_event *ready[EQUEUE_PRIORITIES];
+    struct equeue_event **readytail[EQUEUE_PRIORITIES];
+    unsigned dispatchers;
+    unsigned sleepers;
     unsigned breaks;
-    uint8_t generation;
+#ifdef EQUEUE_EDF
+    unsigned misses;
+#endif
+#ifdef EQUEUE_HISTOGRAMS
+    struct equeue_histogram lateness;
+    struct equeue_histogram runtime;
+#endif
+    uint64_t posts;
+    uint64_t dispatches;
+    uint64_t cancels;
+    unsigned pendinghigh;
+    bool sleeping;
+    equeue_tick_t wakeup;
+    equeue_delta_t spin;
+    equeue_delta_t spinwindow;
+    uint64_t spins;
+    uint64_t parks;
+#ifdef EQUEUE_INGRESS
+    struct equeue_event *ingress;
+#endif
 
     unsigned char *buffer;
     unsigned npw2;
     void *allocated;
 
-    struct equeue_event *chunks;
+    uint32_t chunkmap;
+    struct equeue_event *chunks[EQUEUE_CHUNK_CLASSES];
     struct equeue_slab {
         size_t size;
         unsigned char *data;
     } slab;
+    size_t carved;
+    size_t carvedhigh;
+    size_t pooled[EQUEUE_CHUNK_CLASSES];
+    unsigned live;
+    unsigned failures;
+#if defined(EQUEUE_SLABS) || defined(EQUEUE_COALESCE)
+    size_t slabsize;
+#endif
+#ifdef EQUEUE_SLABS
+    unsigned slabindex;
+    struct equeue_overflow {
+        unsigned char *data;
+        unsigned live;
+        uint8_t id;
+    } slabs[EQUEUE_SLABS];
+#endif
+#ifdef EQUEUE_MAGAZINES
+    struct equeue_magazine {
+        uintptr_t owner;
+        struct equeue_event *chunks[EQUEUE_CHUNK_CLASSES-1];
+        unsigned added[EQUEUE_CHUNK_CLASSES-1];
+        unsigned removed[EQUEUE_CHUNK_CLASSES-1];
+        unsigned taken[EQUEUE_CHUNK_CLASSES-1];
+#ifdef EQUEUE_SLABS
+        bool popping;
+#endif
+    } __attribute__((aligned(EQUEUE_CACHE_LINE))) magazines[EQUEUE_MAGAZINES];
+#endif
+
+#ifdef EQUEUE_FD
+    struct equeue_fds {
+        int epoll;
+        int event;
+        int timer;
+    } fds;
+#endif
+
+#ifdef EQUEUE_TIMERFD
+    struct equeue_timerfd {
+        int fd;
+        bool running;
+        bool stop;
+        pthread_t thread;
+    } timerfd;
+#endif
+
+#ifdef EQUEUE_REACTOR
+    struct equeue_reactor {
+        int epoll;
+        int event;
+    } reactor;
+#endif
+
+#ifdef EQUEUE_TRACE
+    uint32_t tracehead;
+    struct equeue_trace_record trace[EQUEUE_TRACE];
+#endif
+
+    struct equeue_busy {
+        void (*hook)(void *ctx);
+        void *ctx;
+    } busy;
+
+    struct equeue_hooks {
+        void (*before)(void *ctx, void *event, int id,
+                void (*cb)(void *), equeue_tick_t start);
+        void (*after)(void *ctx, void *event, int id,
+                void (*cb)(void *), equeue_tick_t start, equeue_tick_t end);
+        void *ctx;
+    } hooks;
 
     struct equeue_background {
         bool active;
         void (*update)(void *timer, int ms);
         void *timer;
+        equeue_delta_t delta;
     } background;
 
     equeue_sema_t eventsema;
@@ -90,14 +409,49 @@ void equeue_destroy(equeue_t *queue);
 // When called with a finite timeout, the equeue_dispatch function is
 // guaranteed to terminate. When called with a timeout of 0, the
 // equeue_dispatch does not wait and is irq safe.
+//
+// The equeue_dispatch function may be called from multiple threads at once
+// to run the event queue from a pool of workers. Expired events are then
+// handed out to the workers one at a time, so callbacks may run
+// concurrently, but a periodic event never runs concurrently with itself.
 void equeue_dispatch(equeue_t *queue, int ms);
 
 // Break out of a running event loop
 //
-// Forces the specified event queue's dispatch loop to terminate. Pending
-// events may finish executing, but no new events will be executed.
+// Forces one of the specified event queue's dispatch loops to terminate.
+// Pending events may finish executing, but no new events will be executed.
+// A pool of dispatching threads needs one break for each thread.
 void equeue_break(equeue_t *queue);
 
+// Steal an expired event from a busy event queue
+//
+// Dispatches a single expired event from an event queue whose dispatch
+// loops are all busy executing other events. This lets the idle dispatch
+// loop of a sibling queue share the load without waiting for the queue's
+// own dispatch loop.
+//
+// Returns true if an event was dispatched, false if the queue was not
+// being dispatched, had an idle dispatch loop, or had no expired events.
+bool equeue_steal(equeue_t *queue);
+
+// Install a busy hook
+//
+// The busy hook is called with the ctx pointer whenever an event is due
+// on the event queue but no sleeping dispatch loop could be woken for it,
+// either because the event was posted while every dispatch loop was busy
+// or because expired events are left over after a dispatch loop took its
+// next event. The hook lets the idle dispatch loop of a sibling queue be
+// woken to call equeue_steal, instead of polling. It is called from the
+// posting or dispatching thread without any locks held, so it should be
+// short and must not post to the event queue itself.
+//
+// While a busy hook is installed, expired events are handed out to the
+// dispatch loop one at a time, so they are left available to
+// equeue_steal. The hook should be set while the queue is not being
+// dispatched, passing null removes the hook.
+void equeue_set_busy_hook(equeue_t *queue, void (*hook)(void *ctx),
+        void *ctx);
+
 // Simple event calls
 //
 // The specified callback will be executed in the context of the event queue's
@@ -107,6 +461,10 @@ void equeue_break(equeue_t *queue);
 // equeue_call_in    - Post an event after a specified time in milliseconds
 // equeue_call_every - Post an event periodically every milliseconds
 //
+// The _us and _ns variants take microseconds and nanoseconds instead. Their
+// precision is limited by the tick, without EQUEUE_HIGHRES they are rounded
+// up to whole milliseconds.
+//
 // All equeue_call functions are irq safe and can act as a mechanism for
 // moving events out of irq contexts.
 //
@@ -115,7 +473,28 @@ void equeue_break(equeue_t *queue);
 // event, equeue_call returns an id of 0.
 int equeue_call(equeue_t *queue, void (*cb)(void *), void *data);
 int equeue_call_in(equeue_t *queue, int ms, void (*cb)(void *), void *data);
+int equeue_call_in_us(equeue_t *queue, int64_t us,
+        void (*cb)(void *), void *data);
+int equeue_call_in_ns(equeue_t *queue, int64_t ns,
+        void (*cb)(void *), void *data);
 int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
+int equeue_call_every_us(equeue_t *queue, int64_t us,
+        void (*cb)(void *), void *data);
+int equeue_call_every_ns(equeue_t *queue, int64_t ns,
+        void (*cb)(void *), void *data);
+
+// Call a batch of events
+//
+// Immediately posts one event for each of the count data pointers, all
+// with the same callback. The whole batch is allocated under a single
+// acquisition of the queue's locks, posted under another, and signals the
+// dispatch loop at most once.
+//
+// The unique ids of the events are written to the ids array if it is not
+// null. Returns the number of events posted, which is less than count if
+// there is not enough memory, in which case the remaining ids are 0.
+int equeue_call_batch(equeue_t *queue, void (*cb)(void *),
+        void **data, int *ids, int count);
 
 // Allocate memory for events
 //
@@ -128,24 +507,95 @@ int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 //
 // The equeue allocator is designed to minimize jitter in interrupt contexts as
 // well as avoid memory fragmentation on small devices. The allocator achieves
-// both constant-runtime and zero-fragmentation for fixed-size events, however
-// grows linearly as the quantity of different sized allocations increases.
+// both constant-runtime and zero-fragmentation for fixed-size events, and
+// stays constant-runtime for any number of different sizes up to
+// EQUEUE_CHUNK_CLASSES-1 words of event data. Larger events are kept in a
+// single sorted list and are not constant-runtime, their cost grows linearly
+// as the quantity of different sized large allocations increases.
 //
 // The equeue_alloc function returns a pointer to the event's allocated memory
 // and acts as a handle to the underlying event. If there is not enough memory
-// to allocate the event, equeue_alloc returns null.
+// to allocate the event, equeue_alloc returns null. With EQUEUE_SLABS, the
+// event queue first tries to grow into another overflow slab.
 void *equeue_alloc(equeue_t *queue, size_t size);
 void equeue_dealloc(equeue_t *queue, void *event);
 
+// Allocate a batch of events
+//
+// Allocates up to count events of the same size under a single lock and
+// stores them in the events array. Returns the number of events allocated,
+// which is less than count if there is not enough memory.
+int equeue_alloc_batch(equeue_t *queue, size_t size, void **events, int count);
+
 // Configure an allocated event
 //
-// equeue_event_delay  - Millisecond delay before dispatching an event
-// equeue_event_period - Millisecond period for repeating dispatching an event
-// equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_delay    - Millisecond delay before dispatching an event
+// equeue_event_period   - Millisecond period for repeating dispatching an event
+// equeue_event_slack    - Millisecond tolerance for dispatching an event late
+// equeue_event_priority - Priority for dispatching an expired event
+// equeue_event_dtor     - Destructor to run when the event is deallocated
+//
+// The _us and _ns variants take microseconds and nanoseconds, rounded up
+// to the tick.
+//
+// An event with slack may be dispatched up to the slack after its target.
+// Events with overlapping windows are coalesced so the dispatch loop wakes
+// up once for all of them. The slack does not accumulate over the periods
+// of a periodic event.
+//
+// Expired events with a higher priority are dispatched before any expired
+// events with a lower priority. Priorities range from 0, the default, to
+// EQUEUE_PRIORITIES-1, larger priorities are clamped.
 void equeue_event_delay(void *event, int ms);
+void equeue_event_delay_us(void *event, int64_t us);
+void equeue_event_delay_ns(void *event, int64_t ns);
 void equeue_event_period(void *event, int ms);
+void equeue_event_period_us(void *event, int64_t us);
+void equeue_event_period_ns(void *event, int64_t ns);
+void equeue_event_slack(void *event, int ms);
+void equeue_event_slack_us(void *event, int64_t us);
+void equeue_event_slack_ns(void *event, int64_t ns);
+void equeue_event_priority(void *event, int priority);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
 
+#ifdef EQUEUE_EDF
+// Configure the deadline of an allocated event
+//
+// The deadline is the time after the event's target by which the event's
+// callback must complete, a negative deadline, the default, disables the
+// deadline. For periodic events the deadline applies to each period.
+void equeue_event_deadline(void *event, int ms);
+void equeue_event_deadline_us(void *event, int64_t us);
+void equeue_event_deadline_ns(void *event, int64_t ns);
+
+// Count missed deadlines
+//
+// Returns the number of events that have completed after their deadline
+// since the event queue was created.
+unsigned equeue_deadline_misses(equeue_t *queue);
+#endif
+
+#ifdef EQUEUE_HISTOGRAMS
+// Read the dispatch latency histograms
+//
+// Copies out the histogram of lateness, the ticks between an event's
+// target and the start of its callback, and the histogram of callback
+// run times. Immediate posts target the tick they were posted at, so
+// their lateness is the time spent waiting in the queue. Either pointer
+// may be null. The equeue_histograms_reset function clears both.
+void equeue_histograms(equeue_t *queue,
+        struct equeue_histogram *lateness, struct equeue_histogram *runtime);
+void equeue_histograms_reset(equeue_t *queue);
+
+// Find a percentile in a histogram
+//
+// Returns the upper bound in ticks of the bucket holding the percentile,
+// from 0 to 100, of the recorded values, limited to the largest recorded
+// value. Returns 0 if the histogram is empty.
+equeue_tick_t equeue_histogram_percentile(
+        const struct equeue_histogram *histogram, unsigned percentile);
+#endif
+
 // Post an event onto the event queue
 //
 // The equeue_post function takes a callback and a pointer to an event
@@ -160,6 +610,34 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // be passed to equeue_cancel.
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post a batch of events onto the event queue
+//
+// Posts count events allocated by equeue_alloc or equeue_alloc_batch, all
+// with the same callback. The whole batch is scheduled under a single
+// acquisition of the queue's lock and signals the dispatch loop at most
+// once. Events keep their individually configured delays and periods.
+//
+// The unique ids of the events are written to the ids array if it is not
+// null. The equeue_post_batch function is irq safe.
+void equeue_post_batch(equeue_t *queue, void (*cb)(void *),
+        void **events, int *ids, int count);
+
+// Allocate, setup and post a batch of events
+//
+// Allocates up to count events of the same size under a single lock, calls
+// init with each event and its index in the batch, and then posts all of
+// the events with the same callback as with equeue_post_batch. Unlike
+// equeue_alloc_batch, the events are kept in a list internally, so the
+// batch is not limited by the size of a caller's array.
+//
+// The unique ids of the events are written to the ids array if it is not
+// null. Returns the number of events posted, which is less than count if
+// there is not enough memory, in which case the remaining ids are 0. The
+// equeue_emplace_batch function is irq safe if init is.
+int equeue_emplace_batch(equeue_t *queue, size_t size, void (*cb)(void *),
+        void (*init)(void *event, int i, void *data), void *data,
+        int *ids, int count);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -173,6 +651,122 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // the event may have already begun executing.
 void equeue_cancel(equeue_t *queue, int id);
 
+// Reschedule an in-flight event
+//
+// Moves a pending event referenced by its unique id to expire after the
+// specified delay from now, keeping its id and memory. This is cheaper
+// than cancelling the event and posting a new one, for example to refresh
+// a timeout. Periodic events continue with their period from the new
+// expiry.
+//
+// Returns true if the event was rescheduled, or false if the event has
+// already been dispatched, cancelled, or is currently executing, in which
+// case a new event must be posted. The equeue_reschedule function is irq
+// safe.
+bool equeue_reschedule(equeue_t *queue, int id, int ms);
+bool equeue_reschedule_us(equeue_t *queue, int id, int64_t us);
+bool equeue_reschedule_ns(equeue_t *queue, int id, int64_t ns);
+
+// Cancel a batch of in-flight events
+//
+// Attempts to cancel each of the count events referenced by the ids array.
+// All events are removed under a single acquisition of the queue's lock
+// and their memory is returned in a single batch, which is cheaper than
+// cancelling the events individually. Ids of 0 are ignored.
+//
+// If results is not null, each result is set to true if the corresponding
+// event was cancelled before being dispatched. Returns the number of
+// events cancelled. The equeue_cancel_many function is irq safe.
+int equeue_cancel_many(equeue_t *queue, const int *ids, bool *results,
+        int count);
+
+// Query event queue statistics
+//
+// Fills out a snapshot of the event queue's counters. Every post counts
+// once, including each period of a periodic event, and leaves the pending
+// count when its event is dispatched or cancelled, so posts always equal
+// dispatches plus cancels plus pending events.
+//
+// Slab bytes are the bytes carved out of the queue's buffer, and any
+// overflow slabs, into chunks. Free chunks, including chunks cached in
+// magazines, are counted in the chunks array by their size class, the
+// rest of the carved bytes are allocated to events. The counters are
+// maintained as chunks are allocated and freed, under the locks the queue
+// already takes, so a snapshot only copies them and is cheap enough to
+// leave on.
+//
+// The spins and parks count how the dispatch loop's sleeps ended, see
+// equeue_set_spin_ns.
+struct equeue_stats {
+    unsigned pending;           // events posted but not yet dispatched
+    unsigned pending_high;      // high-water mark of pending events
+    uint64_t posts;             // events posted since creation
+    uint64_t dispatches;        // events dispatched since creation
+    uint64_t cancels;           // events cancelled before dispatch
+    unsigned alloc_failures;    // events that failed to allocate
+    size_t slab_used;           // bytes carved into chunks
+    size_t slab_remaining;      // bytes left to carve in the current slab
+    size_t slab_high;           // high-water mark of carved bytes
+    size_t chunks[EQUEUE_CHUNK_CLASSES]; // free chunk bytes by size class
+    unsigned chunks_used;       // chunks allocated to events
+    size_t bytes_used;          // bytes of chunks allocated to events
+    uint64_t spins;             // sleeps spun for instead of parked
+    uint64_t parks;             // sleeps that parked on the semaphore
+};
+
+void equeue_stats(equeue_t *queue, struct equeue_stats *stats);
+
+// Set the dispatch loop's spin budget
+//
+// When the dispatch loop's next deadline is at most ns nanoseconds away,
+// it spins until the deadline instead of parking on its semaphore,
+// polling for posts and breaks with a pause instruction, so close
+// deadlines and events posted in the meantime are picked up without
+// paying the wakeup latency of the platform's semaphore. Waits without a
+// deadline, or with a deadline past the budget, park right away. The
+// budget adapts to the queue, it is halved each time the dispatch loop
+// parks for much longer than the budget and restored once an event
+// arrives close to it.
+//
+// The budget is rounded up to the tick, so without EQUEUE_HIGHRES any
+// budget spins for at least a millisecond. A budget of 0, the default,
+// disables spinning. Spinning requires GCC-style __atomic builtins, and
+// the budget is ignored without them. The spins and parks in
+// equeue_stats can be used to tune the budget.
+void equeue_set_spin_ns(equeue_t *queue, int64_t ns);
+
+// Install dispatch hooks
+//
+// The before hook is called right before each callback runs and the after
+// hook right after it returns, in the context of the dispatching thread.
+// Both are passed the ctx pointer, the event's data as passed to its
+// callback, the event's unique id, the callback, and the ticks at which
+// the callback started and, for the after hook, returned. Either hook may
+// be null, passing null for both removes the hooks.
+//
+// The dispatch loop reads the hooks without the queue's lock, so they
+// should be changed while the queue is not dispatching. Without hooks,
+// callbacks are not timed and dispatch is unaffected.
+void equeue_set_hooks(equeue_t *queue,
+        void (*before)(void *ctx, void *event, int id,
+            void (*cb)(void *), equeue_tick_t start),
+        void (*after)(void *ctx, void *event, int id,
+            void (*cb)(void *), equeue_tick_t start, equeue_tick_t end),
+        void *ctx);
+
+#ifdef EQUEUE_TRACE
+// Dump the trace ring buffer
+//
+// Copies up to count of the most recent trace records, oldest first, and
+// returns the number of records copied. Records still being written are
+// skipped. Writing the records to a file gives a dump that the host tool
+// in tests/trace.c converts into Chrome trace JSON, which can be loaded
+// into chrome://tracing or Perfetto. Dumps of chained queues can be
+// combined into one trace.
+unsigned equeue_trace_dump(equeue_t *queue,
+        struct equeue_trace_record *records, unsigned count);
+#endif
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
@@ -187,6 +781,69 @@ void equeue_cancel(equeue_t *queue, int id);
 void equeue_background(equeue_t *queue,
         void (*update)(void *timer, int ms), void *timer);
 
+#ifdef EQUEUE_FD
+// Get a file descriptor for the event queue
+//
+// Returns a file descriptor that becomes readable when the event queue
+// needs to be dispatched, or a negative error code. The descriptor is an
+// epoll instance watching an eventfd, signalled when events are ready,
+// and a timerfd armed for the next event's target, and can be added to
+// any epoll, poll or select loop.
+//
+// When the descriptor becomes readable, call equeue_dispatch with a
+// timeout of 0, which never blocks. Dispatching clears the descriptor
+// and rearms it for the events that remain.
+//
+// The descriptor backgrounds the event queue with equeue_background, so
+// it replaces any existing background timer. Repeated calls return the
+// same descriptor, which is closed by equeue_destroy.
+int equeue_fd(equeue_t *queue);
+#endif
+
+#ifdef EQUEUE_TIMERFD
+// Background an event queue onto a timerfd
+//
+// Starts a thread that sleeps on a timerfd armed for the next event's
+// target and dispatches the event queue with a timeout of 0 each time the
+// timerfd expires. Events posted from other threads rearm the timerfd to
+// expire immediately. With EQUEUE_HIGHRES the timerfd is armed with the
+// full resolution of the tick instead of the millisecond timeout passed
+// to background update functions.
+//
+// This uses equeue_background, so it replaces any existing background
+// timer, and replacing it stops the thread. The thread is joined by
+// equeue_destroy. Repeated calls while the thread is running do nothing.
+//
+// Returns 0 on success or a negative error code.
+int equeue_background_timerfd(equeue_t *queue);
+#endif
+
+#ifdef EQUEUE_REACTOR
+// Watch a file descriptor for readiness
+//
+// Registers interest in the epoll events, such as EPOLLIN or EPOLLOUT, of
+// a file descriptor. Each time the descriptor becomes ready, an event is
+// posted that calls the callback with the data pointer in the context of
+// the dispatch loop, alongside any other expired events. The descriptor
+// is not watched again until the callback returns, so the callback should
+// consume the readiness, for example by reading until EAGAIN.
+//
+// Returns a handle for equeue_unwatch_fd, or null if the descriptor could
+// not be watched. The watch is allocated from the event queue's memory.
+struct equeue_watch *equeue_watch_fd(equeue_t *queue, int fd,
+        uint32_t events, void (*cb)(void *), void *data);
+
+// Stop watching a file descriptor
+//
+// After equeue_unwatch_fd returns, the callback is not called again and
+// the descriptor may be closed. The equeue_unwatch_fd function must be
+// called from the thread dispatching the event queue, such as from an
+// event's callback, or while the event queue is not dispatching. With
+// several dispatch loops, a callback that already started on another
+// dispatch loop may still be running when equeue_unwatch_fd returns.
+void equeue_unwatch_fd(equeue_t *queue, struct equeue_watch *watch);
+#endif
+
 // Chain an event queue onto another event queue
 //
 // After chaining a queue to a target, calling equeue_dispatch on the
@@ -0,0 +1,173 @@
+/*
+ * Implementation for Linux using futexes
+ *
+ * Copyright (c) 2016 Christopher Haster
+ * Distributed under the MIT license
+ */
+// syscall is only declared for gnu sources
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "equeue_platform.h"
+
+#if defined(EQUEUE_PLATFORM_LINUX)
+
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+// Futex operations, these are process private
+static int equeue_futex_wait(int *addr, int val,
+        const struct timespec *timeout) {
+    return syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeout, 0, 0);
+}
+
+static void equeue_futex_wake(int *addr, int count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+}
+
+// hint to the processor that we are busy-waiting
+static inline void equeue_cpu_relax(void) {
+#if defined(__i386__) || defined(__x86_64__)
+    __asm__ volatile ("pause");
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+    __asm__ volatile ("yield");
+#endif
+}
+
+
+
+// Tick operations
+#if defined(EQUEUE_HIGHRES)
+equeue_tick_t equeue_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (equeue_tick_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+#else
+equeue_tick_t equeue_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned)(ts.tv_sec*1000 + ts.tv_nsec/1000000);
+}
+#endif
+
+
+// Mutex operations
+//
+// The lock word is 0 when unlocked, 1 when locked, and 2 when locked with
+// possible sleepers, so an uncontended lock and unlock are a single atomic
+// operation each. Before sleeping, a locker spins for a count that adapts
+// to how long the lock was recently held, similar to glibc's adaptive
+// mutexes.
+#define EQUEUE_MUTEX_SPINS 100
+
+int equeue_mutex_create(equeue_mutex_t *m) {
+    m->state = 0;
+    m->spins = 0;
+    return 0;
+}
+
+void equeue_mutex_destroy(equeue_mutex_t *m) {
+    (void)m;
+}
+
+void equeue_mutex_lock(equeue_mutex_t *m) {
+    int c = 0;
+    if (__atomic_compare_exchange_n(&m->state, &c, 1, false,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    // spin while the lock is held without sleepers, the spin estimate is
+    // only a hint so races on it are harmless
+    int estimate = __atomic_load_n(&m->spins, __ATOMIC_RELAXED);
+    int limit = 2*estimate + 10;
+    if (limit > EQUEUE_MUTEX_SPINS) {
+        limit = EQUEUE_MUTEX_SPINS;
+    }
+
+    int spins = 0;
+    while (spins < limit) {
+        spins++;
+        equeue_cpu_relax();
+
+        c = __atomic_load_n(&m->state, __ATOMIC_RELAXED);
+        if (c == 0 && __atomic_compare_exchange_n(&m->state, &c, 1, false,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&m->spins,
+                    estimate + (spins - estimate) / 8, __ATOMIC_RELAXED);
+            return;
+        } else if (c == 2) {
+            break;
+        }
+    }
+    __atomic_store_n(&m->spins,
+            estimate + (spins - estimate) / 8, __ATOMIC_RELAXED);
+
+    // mark the lock as contended and sleep until it is released
+    while (__atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE) != 0) {
+        equeue_futex_wait(&m->state, 2, 0);
+    }
+}
+
+void equeue_mutex_unlock(equeue_mutex_t *m) {
+    if (__atomic_exchange_n(&m->state, 0, __ATOMIC_RELEASE) == 2) {
+        equeue_futex_wake(&m->state, 1);
+    }
+}
+
+
+// Semaphore operations
+//
+// The futex word is 1 while signalled, signalling only enters the kernel
+// if a waiter may be sleeping on the word.
+int equeue_sema_create(equeue_sema_t *s) {
+    s->signal = 0;
+    s->waiters = 0;
+    return 0;
+}
+
+void equeue_sema_destroy(equeue_sema_t *s) {
+    (void)s;
+}
+
+void equeue_sema_signal(equeue_sema_t *s) {
+    __atomic_store_n(&s->signal, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST)) {
+        equeue_futex_wake(&s->signal, 1);
+    }
+}
+
+bool equeue_sema_wait(equeue_sema_t *s, equeue_delta_t ticks) {
+    if (__atomic_exchange_n(&s->signal, 0, __ATOMIC_ACQUIRE)) {
+        return true;
+    }
+
+    if (ticks == 0) {
+        return false;
+    }
+
+    // the futex rechecks the word before sleeping, so a signal between
+    // registering as a waiter and sleeping is not lost
+    struct timespec ts;
+    if (ticks > 0) {
+#if defined(EQUEUE_HIGHRES)
+        ts.tv_sec = ticks / 1000000000;
+        ts.tv_nsec = ticks % 1000000000;
+#else
+        ts.tv_sec = ticks / 1000;
+        ts.tv_nsec = (ticks % 1000) * 1000000;
+#endif
+    }
+
+    __atomic_add_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    equeue_futex_wait(&s->signal, 0, ticks > 0 ? &ts : 0);
+    __atomic_sub_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+
+    return __atomic_exchange_n(&s->signal, 0, __ATOMIC_ACQUIRE);
+}
+
+#endif
@@ -12,18 +12,21 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Currently supported platforms
 //
 // Uncomment to select a supported platform or reimplement this file
 // for a specific target.
 //#define EQUEUE_PLATFORM_POSIX
+//#define EQUEUE_PLATFORM_LINUX
 //#define EQUEUE_PLATFORM_WINDOWS
 //#define EQUEUE_PLATFORM_MBED
 //#define EQUEUE_PLATFORM_FREERTOS
 
 // Try to infer a platform if none was manually selected
 #if !defined(EQUEUE_PLATFORM_POSIX)     \
+ && !defined(EQUEUE_PLATFORM_LINUX)     \
  && !defined(EQUEUE_PLATFORM_WINDOWS)   \
  && !defined(EQUEUE_PLATFORM_MBED)      \
  && !defined(EQUEUE_PLATFORM_FREERTOS)
@@ -38,6 +41,18 @@ extern "C" {
 #endif
 #endif
 
+// High-resolution timing
+//
+// Define EQUEUE_HIGHRES to replace the 32-bit millisecond tick with a
+// 64-bit nanosecond tick read from a monotonic clock. Delays and periods
+// can then be specified with sub-millisecond precision. Currently only
+// supported on posix and linux platforms.
+//#define EQUEUE_HIGHRES
+#if defined(EQUEUE_HIGHRES) \
+ && !defined(EQUEUE_PLATFORM_POSIX) && !defined(EQUEUE_PLATFORM_LINUX)
+#error "EQUEUE_HIGHRES is only supported on posix and linux platforms"
+#endif
+
 // Platform includes
 #if defined(EQUEUE_PLATFORM_POSIX)
 #include <pthread.h>
@@ -49,15 +64,36 @@ extern "C" {
 #endif
 
 
-// Platform millisecond counter
+// Platform tick type
+//
+// The equeue_tick_t type holds an absolute tick and the equeue_delta_t
+// type holds the signed difference between two ticks. Ticks are
+// milliseconds by default, or nanoseconds with EQUEUE_HIGHRES.
+#if defined(EQUEUE_HIGHRES)
+typedef uint64_t equeue_tick_t;
+typedef int64_t equeue_delta_t;
+#define EQUEUE_TICK_BITS 64
+#define EQUEUE_TICK_NS 1
+#else
+typedef unsigned equeue_tick_t;
+typedef int equeue_delta_t;
+#define EQUEUE_TICK_BITS 32
+#define EQUEUE_TICK_NS 1000000
+#endif
+#define EQUEUE_TICKS_PER_MS (1000000 / EQUEUE_TICK_NS)
+
+// Platform tick counter
 //
 // Return a tick that represents the number of milliseconds that have passed
 // since an arbitrary point in time. The granularity does not need to be at
 // the millisecond level, however the accuracy of the equeue library is
 // limited by the accuracy of this tick.
 //
-// Must intentionally overflow to 0 after 2^32-1
-unsigned equeue_tick(void);
+// With EQUEUE_HIGHRES the tick counts nanoseconds of a monotonic clock
+// instead.
+//
+// Must intentionally overflow to 0 after 2^EQUEUE_TICK_BITS-1
+equeue_tick_t equeue_tick(void);
 
 
 // Platform mutex type
@@ -69,6 +105,11 @@ unsigned equeue_tick(void);
 // If irq safety is not required, a regular blocking mutex can be used.
 #if defined(EQUEUE_PLATFORM_POSIX)
 typedef pthread_mutex_t equeue_mutex_t;
+#elif defined(EQUEUE_PLATFORM_LINUX)
+typedef struct equeue_mutex {
+    int state;
+    int spins;
+} equeue_mutex_t;
 #elif defined(EQUEUE_PLATFORM_WINDOWS)
 typedef CRITICAL_SECTION equeue_mutex_t;
 #elif defined(EQUEUE_PLATFORM_MBED)
@@ -108,6 +149,11 @@ typedef struct equeue_sema {
     pthread_cond_t cond;
     bool signal;
 } equeue_sema_t;
+#elif defined(EQUEUE_PLATFORM_LINUX)
+typedef struct equeue_sema {
+    int signal;
+    int waiters;
+} equeue_sema_t;
 #elif defined(EQUEUE_PLATFORM_WINDOWS)
 typedef HANDLE equeue_sema_t;
 #elif defined(EQUEUE_PLATFORM_MBED) && defined(MBED_CONF_RTOS_PRESENT)
@@ -133,11 +179,12 @@ typedef struct equeue_sema {
 // The equeue_sema_wait waits for a semaphore to be signalled or returns
 // immediately if equeue_sema_signal had been called since the last
 // equeue_sema_wait. The equeue_sema_wait returns true if it detected that
-// equeue_sema_signal had been called.
+// equeue_sema_signal had been called. The timeout is given in ticks and a
+// negative timeout waits indefinitely.
 int equeue_sema_create(equeue_sema_t *sema);
 void equeue_sema_destroy(equeue_sema_t *sema);
 void equeue_sema_signal(equeue_sema_t *sema);
-bool equeue_sema_wait(equeue_sema_t *sema, int ms);
+bool equeue_sema_wait(equeue_sema_t *sema, equeue_delta_t ticks);
 
 
 #ifdef __cplusplus
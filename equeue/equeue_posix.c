@@ -14,11 +14,19 @@
 
 
 // Tick operations
-unsigned equeue_tick(void) {
+#if defined(EQUEUE_HIGHRES)
+equeue_tick_t equeue_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (equeue_tick_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+#else
+equeue_tick_t equeue_tick(void) {
     struct timeval tv;
     gettimeofday(&tv, 0);
     return (unsigned)(tv.tv_sec*1000 + tv.tv_usec/1000);
 }
+#endif
 
 
 // Mutex operations
@@ -46,7 +54,22 @@ int equeue_sema_create(equeue_sema_t *s) {
         return err;
     }
 
+#if defined(EQUEUE_HIGHRES)
+    // time out against the same monotonic clock as the tick
+    pthread_condattr_t attr;
+    err = pthread_condattr_init(&attr);
+    if (err) {
+        return err;
+    }
+
+    err = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (!err) {
+        err = pthread_cond_init(&s->cond, &attr);
+    }
+    pthread_condattr_destroy(&attr);
+#else
     err = pthread_cond_init(&s->cond, 0);
+#endif
     if (err) {
         return err;
     }
@@ -67,19 +90,30 @@ void equeue_sema_signal(equeue_sema_t *s) {
     pthread_mutex_unlock(&s->mutex);
 }
 
-bool equeue_sema_wait(equeue_sema_t *s, int ms) {
+bool equeue_sema_wait(equeue_sema_t *s, equeue_delta_t ticks) {
     pthread_mutex_lock(&s->mutex);
     if (!s->signal) {
-        if (ms < 0) {
+        if (ticks < 0) {
             pthread_cond_wait(&s->cond, &s->mutex);
         } else {
+#if defined(EQUEUE_HIGHRES)
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ts.tv_sec += ticks / 1000000000;
+            ts.tv_nsec += ticks % 1000000000;
+#else
             struct timeval tv;
             gettimeofday(&tv, 0);
 
             struct timespec ts = {
-                .tv_sec = ms/1000 + tv.tv_sec,
-                .tv_nsec = ms*1000000 + tv.tv_usec*1000,
+                .tv_sec = ticks/1000 + tv.tv_sec,
+                .tv_nsec = (ticks%1000)*1000000 + tv.tv_usec*1000,
             };
+#endif
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec += 1;
+                ts.tv_nsec -= 1000000000;
+            }
 
             pthread_cond_timedwait(&s->cond, &s->mutex, &ts);
         }
@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <inttypes.h>
 #include <sys/time.h>
+#include <pthread.h>
+#include <sched.h>
 
 
 // Performance measurement utils
@@ -105,6 +107,44 @@ static const char *prof_units;
 void no_func(void *eh) {
 }
 
+void stop_func(void *eh) {
+    prof_stop();
+}
+
+
+struct prof_producer {
+    pthread_t thread;
+    equeue_t *q;
+    void **es;
+    int count;
+};
+
+static void *prof_dispatch_thread(void *p) {
+    equeue_dispatch((equeue_t *)p, -1);
+    return 0;
+}
+
+static void *prof_producer_thread(void *p) {
+    struct prof_producer *producer = (struct prof_producer *)p;
+    for (int i = 0; i < producer->count; i++) {
+        if (producer->es) {
+            equeue_post(producer->q, no_func, producer->es[i]);
+        } else {
+            while (!equeue_call(producer->q, no_func, 0));
+        }
+    }
+    return 0;
+}
+
+static void *prof_allocator_thread(void *p) {
+    struct prof_producer *producer = (struct prof_producer *)p;
+    for (int i = 0; i < producer->count; i++) {
+        void *e = equeue_alloc(producer->q, 8 * sizeof(int));
+        equeue_dealloc(producer->q, e);
+    }
+    return 0;
+}
+
 
 // Actual performance tests
 void baseline_prof(void) {
@@ -116,7 +156,7 @@ void baseline_prof(void) {
 }
 
 void equeue_tick_prof(void) {
-    prof_volatile(unsigned) res;
+    prof_volatile(equeue_tick_t) res;
     prof_loop() {
         prof_start();
         res = equeue_tick();
@@ -124,6 +164,57 @@ void equeue_tick_prof(void) {
     }
 }
 
+void equeue_mutex_prof(void) {
+    equeue_mutex_t mutex;
+    equeue_mutex_create(&mutex);
+
+    prof_loop() {
+        prof_start();
+        equeue_mutex_lock(&mutex);
+        equeue_mutex_unlock(&mutex);
+        prof_stop();
+    }
+
+    equeue_mutex_destroy(&mutex);
+}
+
+void equeue_sema_prof(void) {
+    equeue_sema_t sema;
+    equeue_sema_create(&sema);
+
+    prof_loop() {
+        prof_start();
+        equeue_sema_signal(&sema);
+        equeue_sema_wait(&sema, 0);
+        prof_stop();
+    }
+
+    equeue_sema_destroy(&sema);
+}
+
+void equeue_wakeup_prof(void) {
+    struct equeue q;
+    equeue_create(&q, 2*EQUEUE_EVENT_SIZE);
+
+    pthread_t dispatcher;
+    pthread_create(&dispatcher, 0, prof_dispatch_thread, &q);
+
+    // latency of waking a sleeping dispatch loop on another thread
+    prof_loop() {
+        usleep(100);
+        void *e = equeue_alloc(&q, 0);
+        prof_cycle_t stopped = prof_stop_cycle;
+
+        prof_start();
+        equeue_post(&q, stop_func, e);
+        while (prof_stop_cycle == stopped);
+    }
+
+    equeue_break(&q);
+    pthread_join(dispatcher, 0);
+    equeue_destroy(&q);
+}
+
 void equeue_alloc_prof(void) {
     struct equeue q;
     equeue_create(&q, 32*EQUEUE_EVENT_SIZE);
@@ -164,6 +255,31 @@ void equeue_alloc_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+void equeue_alloc_sizes_prof(int sizes) {
+    struct equeue q;
+    equeue_create(&q, sizes*(EQUEUE_EVENT_SIZE + sizes*sizeof(void*)));
+
+    void *es[sizes];
+
+    for (int i = 0; i < sizes; i++) {
+        es[i] = equeue_alloc(&q, i * sizeof(void*));
+    }
+
+    for (int i = 0; i < sizes; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    prof_loop() {
+        prof_start();
+        void *e = equeue_alloc(&q, (sizes-1) * sizeof(void*));
+        prof_stop();
+
+        equeue_dealloc(&q, e);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_post_prof(void) {
     struct equeue q;
     equeue_create(&q, EQUEUE_EVENT_SIZE);
@@ -202,6 +318,83 @@ void equeue_post_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+void equeue_call_many_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    prof_loop() {
+        prof_start();
+        for (int i = 0; i < count; i++) {
+            equeue_call(&q, no_func, 0);
+        }
+        prof_stop();
+
+        equeue_dispatch(&q, 0);
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_call_batch_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    void *data[count];
+    for (int i = 0; i < count; i++) {
+        data[i] = 0;
+    }
+
+    prof_loop() {
+        prof_start();
+        equeue_call_batch(&q, no_func, data, 0, count);
+        prof_stop();
+
+        equeue_dispatch(&q, 0);
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_cancel_each_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    int ids[count];
+
+    prof_loop() {
+        for (int i = 0; i < count; i++) {
+            ids[i] = equeue_call_in(&q, 1000, no_func, 0);
+        }
+
+        prof_start();
+        for (int i = 0; i < count; i++) {
+            equeue_cancel(&q, ids[i]);
+        }
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_cancel_batch_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    int ids[count];
+
+    prof_loop() {
+        for (int i = 0; i < count; i++) {
+            ids[i] = equeue_call_in(&q, 1000, no_func, 0);
+        }
+
+        prof_start();
+        equeue_cancel_many(&q, ids, 0, count);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_post_future_prof(void) {
     struct equeue q;
     equeue_create(&q, EQUEUE_EVENT_SIZE);
@@ -242,6 +435,28 @@ void equeue_post_future_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+void equeue_post_future_spread_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count-1; i++) {
+        equeue_call_in(&q, 1000 + i, no_func, 0);
+    }
+
+    prof_loop() {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, 1000 + count);
+
+        prof_start();
+        int id = equeue_post(&q, no_func, e);
+        prof_stop();
+
+        equeue_cancel(&q, id);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_dispatch_prof(void) {
     struct equeue q;
     equeue_create(&q, EQUEUE_EVENT_SIZE);
@@ -289,6 +504,37 @@ void equeue_cancel_prof(void) {
     equeue_destroy(&q);
 }
 
+void equeue_recall_prof(void) {
+    struct equeue q;
+    equeue_create(&q, EQUEUE_EVENT_SIZE);
+
+    int id = equeue_call_in(&q, 1000, no_func, 0);
+
+    prof_loop() {
+        prof_start();
+        equeue_cancel(&q, id);
+        id = equeue_call_in(&q, 1000, no_func, 0);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_reschedule_prof(void) {
+    struct equeue q;
+    equeue_create(&q, EQUEUE_EVENT_SIZE);
+
+    int id = equeue_call_in(&q, 1000, no_func, 0);
+
+    prof_loop() {
+        prof_start();
+        equeue_reschedule(&q, id, 1000);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_cancel_many_prof(int count) {
     struct equeue q;
     equeue_create(&q, count*EQUEUE_EVENT_SIZE);
@@ -308,6 +554,182 @@ void equeue_cancel_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+// worst-case latency of an urgent event posted behind count bulk events,
+// the dispatch loop is held in a gate event while the bulk events are
+// posted so they are all ready ahead of the urgent event
+static volatile int prof_latency_gate;
+static volatile int prof_latency_done;
+static prof_cycle_t prof_latency_worst;
+
+void prof_gate_func(void *eh) {
+    prof_latency_gate = 1;
+    while (prof_latency_gate != 2) {
+        sched_yield();
+    }
+}
+
+void prof_bulk_func(void *eh) {
+    prof_latency_done++;
+}
+
+void prof_urgent_func(void *eh) {
+    prof_stop();
+    prof_cycle_t latency = prof_stop_cycle - prof_start_cycle;
+    if (latency > prof_latency_worst) {
+        prof_latency_worst = latency;
+    }
+    prof_latency_done++;
+}
+
+static void prof_latency(int count, uint8_t priority) {
+    struct equeue q;
+    equeue_create(&q, (count+2)*EQUEUE_EVENT_SIZE);
+
+    pthread_t dispatcher;
+    pthread_create(&dispatcher, 0, prof_dispatch_thread, &q);
+
+    prof_latency_worst = 0;
+    prof_loop() {
+        prof_latency_gate = 0;
+        prof_latency_done = 0;
+        equeue_call(&q, prof_gate_func, 0);
+        while (prof_latency_gate != 1) {
+            sched_yield();
+        }
+
+        for (int i = 0; i < count; i++) {
+            equeue_call(&q, prof_bulk_func, 0);
+        }
+
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_priority(e, priority);
+        prof_start();
+        equeue_post(&q, prof_urgent_func, e);
+        prof_latency_gate = 2;
+
+        while (prof_latency_done < count+1) {
+            sched_yield();
+        }
+    }
+
+    equeue_break(&q);
+    pthread_join(dispatcher, 0);
+    equeue_destroy(&q);
+
+    prof_result(prof_latency_worst, "cycles");
+}
+
+void equeue_fifo_latency_prof(int count) {
+    prof_latency(count, 0);
+}
+
+void equeue_priority_latency_prof(int count) {
+    prof_latency(count, EQUEUE_PRIORITIES-1);
+}
+
+void equeue_post_contended_prof(int producers) {
+    int count = 10000;
+
+    struct equeue q;
+    equeue_create(&q, producers*count*EQUEUE_EVENT_SIZE);
+
+    struct prof_producer ps[producers];
+    for (int i = 0; i < producers; i++) {
+        ps[i].q = &q;
+        ps[i].count = count;
+        ps[i].es = malloc(count*sizeof(void*));
+        for (int j = 0; j < count; j++) {
+            ps[i].es[j] = equeue_alloc(&q, 0);
+        }
+    }
+
+    pthread_t dispatcher;
+    pthread_create(&dispatcher, 0, prof_dispatch_thread, &q);
+
+    prof_cycle_t start = prof_cycle();
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&ps[i].thread, 0, prof_producer_thread, &ps[i]);
+    }
+
+    for (int i = 0; i < producers; i++) {
+        pthread_join(ps[i].thread, 0);
+    }
+    prof_cycle_t cycles = prof_cycle() - start;
+
+    equeue_break(&q);
+    pthread_join(dispatcher, 0);
+
+    for (int i = 0; i < producers; i++) {
+        free(ps[i].es);
+    }
+
+    prof_result(cycles / (producers*count), "cycles");
+
+    equeue_destroy(&q);
+}
+
+void equeue_alloc_contended_prof(int threads) {
+    int count = 100000;
+
+    struct equeue q;
+    equeue_create(&q, 256*EQUEUE_EVENT_SIZE);
+
+    struct prof_producer ps[threads];
+    for (int i = 0; i < threads; i++) {
+        ps[i].q = &q;
+        ps[i].count = count;
+        ps[i].es = 0;
+    }
+
+    prof_cycle_t start = prof_cycle();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&ps[i].thread, 0, prof_allocator_thread, &ps[i]);
+    }
+
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ps[i].thread, 0);
+    }
+    prof_cycle_t cycles = prof_cycle() - start;
+
+    prof_result(cycles / (threads*count), "cycles");
+
+    equeue_destroy(&q);
+}
+
+void equeue_call_contended_prof(int producers) {
+    int count = 10000;
+
+    struct equeue q;
+    equeue_create(&q, 256*EQUEUE_EVENT_SIZE);
+
+    struct prof_producer ps[producers];
+    for (int i = 0; i < producers; i++) {
+        ps[i].q = &q;
+        ps[i].count = count;
+        ps[i].es = 0;
+    }
+
+    pthread_t dispatcher;
+    pthread_create(&dispatcher, 0, prof_dispatch_thread, &q);
+
+    prof_cycle_t start = prof_cycle();
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&ps[i].thread, 0, prof_producer_thread, &ps[i]);
+    }
+
+    for (int i = 0; i < producers; i++) {
+        pthread_join(ps[i].thread, 0);
+    }
+    prof_cycle_t cycles = prof_cycle() - start;
+
+    equeue_break(&q);
+    pthread_join(dispatcher, 0);
+
+    prof_result(cycles / (producers*count), "cycles");
+
+    equeue_destroy(&q);
+}
+
 void equeue_alloc_size_prof(void) {
     size_t size = 32*EQUEUE_EVENT_SIZE;
 
@@ -376,17 +798,40 @@ int main() {
     prof_baseline(baseline_prof);
 
     prof_measure(equeue_tick_prof);
+    prof_measure(equeue_mutex_prof);
+    prof_measure(equeue_sema_prof);
+    prof_measure(equeue_wakeup_prof);
     prof_measure(equeue_alloc_prof);
     prof_measure(equeue_post_prof);
     prof_measure(equeue_post_future_prof);
     prof_measure(equeue_dispatch_prof);
     prof_measure(equeue_cancel_prof);
+    prof_measure(equeue_recall_prof);
+    prof_measure(equeue_reschedule_prof);
 
     prof_measure(equeue_alloc_many_prof, 1000);
+    prof_measure(equeue_alloc_sizes_prof, 12);
     prof_measure(equeue_post_many_prof, 1000);
     prof_measure(equeue_post_future_many_prof, 1000);
+    prof_measure(equeue_post_future_spread_prof, 1000);
+    prof_measure(equeue_call_many_prof, 16);
+    prof_measure(equeue_call_batch_prof, 16);
+    prof_measure(equeue_call_many_prof, 1000);
+    prof_measure(equeue_call_batch_prof, 1000);
+    prof_measure(equeue_cancel_each_prof, 16);
+    prof_measure(equeue_cancel_batch_prof, 16);
     prof_measure(equeue_dispatch_many_prof, 100);
     prof_measure(equeue_cancel_many_prof, 100);
+    prof_measure(equeue_fifo_latency_prof, 100);
+    prof_measure(equeue_priority_latency_prof, 100);
+
+    prof_measure(equeue_post_contended_prof, 2);
+    prof_measure(equeue_post_contended_prof, 4);
+    prof_measure(equeue_post_contended_prof, 8);
+    prof_measure(equeue_post_contended_prof, 16);
+    prof_measure(equeue_alloc_contended_prof, 1);
+    prof_measure(equeue_alloc_contended_prof, 4);
+    prof_measure(equeue_call_contended_prof, 4);
 
     prof_measure(equeue_alloc_size_prof);
     prof_measure(equeue_alloc_many_size_prof, 1000);
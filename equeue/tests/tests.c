@@ -10,7 +10,15 @@
 #include <setjmp.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
+#ifdef EQUEUE_FD
+#include <poll.h>
+#endif
+#ifdef EQUEUE_REACTOR
+#include <fcntl.h>
+#include <sys/epoll.h>
+#endif
 
 
 // Testing setup
@@ -39,8 +47,17 @@ static int test_failure;
 })
 
 
+// Number of buffers an event queue can allocate from
+#ifdef EQUEUE_SLABS
+#define TEST_SLABS (1+EQUEUE_SLABS)
+#else
+#define TEST_SLABS 1
+#endif
+
+
 // Test functions
 void pass_func(void *eh) {
+    (void)eh;
 }
 
 void simple_func(void *p) {
@@ -63,16 +80,16 @@ void indirect_func(void *p) {
 }
 
 struct timing {
-    unsigned tick;
+    equeue_tick_t tick;
     unsigned delay;
 };
 
 void timing_func(void *p) {
     struct timing *timing = (struct timing*)p;
-    unsigned tick = equeue_tick();
+    equeue_tick_t tick = equeue_tick();
 
     unsigned t1 = timing->delay;
-    unsigned t2 = tick - timing->tick;
+    unsigned t2 = (tick - timing->tick) / EQUEUE_TICKS_PER_MS;
     test_assert(t1 > t2 - 10 && t1 < t2 + 10);
 
     timing->tick = tick;
@@ -108,6 +125,17 @@ void cancel_func(void *p) {
     equeue_cancel(cancel->q, cancel->id);
 }
 
+struct order {
+    int *count;
+    int expected;
+};
+
+void order_func(void *p) {
+    struct order *order = (struct order *)p;
+    test_assert(*order->count == order->expected);
+    (*order->count)++;
+}
+
 struct nest {
     equeue_t *q;
     void (*cb)(void *);
@@ -250,7 +278,7 @@ void allocation_failure_test(void) {
     void *p = equeue_alloc(&q, 4096);
     test_assert(!p);
 
-    for (int i = 0; i < 100; i++) {
+    for (int i = 0; i < 100*TEST_SLABS; i++) {
         p = equeue_alloc(&q, 0);
     }
     test_assert(!p);
@@ -365,6 +393,187 @@ void loop_protect_test(void) {
     equeue_destroy(&q);
 }
 
+void order_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*(EQUEUE_EVENT_SIZE+sizeof(struct order)));
+    test_assert(!err);
+
+    // events with equal delays must run in the order they were posted
+    int count = 0;
+    for (int i = 0; i < N; i++) {
+        struct order *order = equeue_alloc(&q, sizeof(struct order));
+        test_assert(order);
+
+        int slot = (7*i) % 8;
+        order->count = &count;
+        order->expected = slot*(N/8) + i/8;
+        equeue_event_delay(order, slot*10);
+
+        int id = equeue_post(&q, order_func, order);
+        test_assert(id);
+    }
+
+    // far events across the upper levels of the wheel should be cancelable
+    int id1 = equeue_call_in(&q, 1 << 20, pass_func, 0);
+    int id2 = equeue_call_in(&q, 0x7fffffff, pass_func, 0);
+    test_assert(id1 && id2);
+
+    equeue_dispatch(&q, 80);
+    test_assert(count == N);
+
+    equeue_cancel(&q, id1);
+    equeue_cancel(&q, id2);
+
+    equeue_destroy(&q);
+}
+
+void priority_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, (N+1)*(EQUEUE_EVENT_SIZE+sizeof(struct order)));
+    test_assert(!err);
+
+    // expired events run by priority and then in the order they were posted
+    int counts[EQUEUE_PRIORITIES] = {0};
+    for (int i = 0; i < N; i++) {
+        counts[(3*i) % EQUEUE_PRIORITIES] += 1;
+    }
+
+    int offsets[EQUEUE_PRIORITIES];
+    int offset = 0;
+    for (int p = EQUEUE_PRIORITIES-1; p >= 0; p--) {
+        offsets[p] = offset;
+        offset += counts[p];
+    }
+
+    int count = 0;
+    for (int i = 0; i < N; i++) {
+        struct order *order = equeue_alloc(&q, sizeof(struct order));
+        test_assert(order);
+
+        int priority = (3*i) % EQUEUE_PRIORITIES;
+        order->count = &count;
+        order->expected = offsets[priority]++;
+        equeue_event_priority(order, priority);
+
+        int id = equeue_post(&q, order_func, order);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == N);
+
+    // out of range priorities are clamped
+    count = 0;
+    struct order *order = equeue_alloc(&q, sizeof(struct order));
+    test_assert(order);
+    order->count = &count;
+    order->expected = (EQUEUE_PRIORITIES > 1) ? 1 : 0;
+    equeue_event_priority(order, -1);
+    test_assert(equeue_post(&q, order_func, order));
+
+    order = equeue_alloc(&q, sizeof(struct order));
+    test_assert(order);
+    order->count = &count;
+    order->expected = (EQUEUE_PRIORITIES > 1) ? 0 : 1;
+    equeue_event_priority(order, 1000);
+    test_assert(equeue_post(&q, order_func, order));
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 2);
+
+    equeue_destroy(&q);
+}
+
+#ifdef EQUEUE_EDF
+void edf_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, (N+2)*(EQUEUE_EVENT_SIZE+sizeof(struct order)));
+    test_assert(!err);
+
+    // expired events run in order of their deadlines, ahead of events
+    // without deadlines
+    int count = 0;
+    struct order *order = equeue_alloc(&q, sizeof(struct order));
+    test_assert(order);
+    order->count = &count;
+    order->expected = N;
+    test_assert(equeue_post(&q, order_func, order));
+
+    for (int i = 0; i < N; i++) {
+        order = equeue_alloc(&q, sizeof(struct order));
+        test_assert(order);
+
+        int slot = (7*i) % 8;
+        order->count = &count;
+        order->expected = slot*(N/8) + i/8;
+        equeue_event_deadline(order, 10 + slot*10);
+
+        int id = equeue_post(&q, order_func, order);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == N+1);
+    test_assert(equeue_deadline_misses(&q) == 0);
+
+    // events held up past their deadline are counted as misses
+    int touched = 0;
+    test_assert(equeue_call(&q, sloth_func, &touched));
+
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+    i->touched = &touched;
+    equeue_event_delay(i, 1);
+    equeue_event_deadline(i, 1);
+    test_assert(equeue_post(&q, indirect_func, i));
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == 2);
+    test_assert(equeue_deadline_misses(&q) == 1);
+
+    equeue_destroy(&q);
+}
+#endif
+
+#ifdef EQUEUE_HISTOGRAMS
+void histogram_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    for (int i = 0; i < N; i++) {
+        equeue_call(&q, simple_func, &touched);
+    }
+    equeue_call(&q, sloth_func, &touched);
+
+    // the sloth delays every event behind it
+    equeue_call_in(&q, 5, simple_func, &touched);
+    equeue_dispatch(&q, 30);
+    test_assert(touched == N+2);
+
+    struct equeue_histogram lateness, runtime;
+    equeue_histograms(&q, &lateness, &runtime);
+    test_assert(lateness.count == (uint64_t)(N+2));
+    test_assert(runtime.count == (uint64_t)(N+2));
+
+    equeue_tick_t p50 = equeue_histogram_percentile(&runtime, 50);
+    equeue_tick_t p100 = equeue_histogram_percentile(&runtime, 100);
+    test_assert(p50 < 5*EQUEUE_TICKS_PER_MS);
+    test_assert(p100 >= 9*EQUEUE_TICKS_PER_MS);
+    test_assert(p100 == runtime.max);
+    test_assert(equeue_histogram_percentile(&lateness, 100)
+            >= 4*EQUEUE_TICKS_PER_MS);
+
+    equeue_histograms_reset(&q);
+    equeue_histograms(&q, &lateness, 0);
+    test_assert(lateness.count == 0);
+    test_assert(equeue_histogram_percentile(&lateness, 50) == 0);
+
+    equeue_destroy(&q);
+}
+#endif
+
 void break_test(void) {
     equeue_t q;
     int err = equeue_create(&q, 2048);
@@ -480,37 +689,1233 @@ void multithread_test(void) {
     equeue_destroy(&q);
 }
 
-void background_func(void *p, int ms) {
-    *(unsigned *)p = ms;
+void wakeup_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    int id = equeue_call_in(&q, 1000, pass_func, 0);
+    test_assert(id);
+
+    pthread_t thread;
+    err = pthread_create(&thread, 0, multithread_thread, &q);
+    test_assert(!err);
+
+    // a sleeping dispatch loop must still wake up for earlier events
+    usleep(10000);
+    id = equeue_call(&q, simple_func, &touched);
+    test_assert(id);
+    usleep(10000);
+    test_assert(touched == 1);
+
+    id = equeue_call_in(&q, 10, simple_func, &touched);
+    test_assert(id);
+    usleep(20000);
+    test_assert(touched == 2);
+
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    equeue_destroy(&q);
 }
 
-void background_test(void) {
+struct producer {
+    pthread_t thread;
+    equeue_t *q;
+    int *touched;
+    int count;
+};
+
+void *multiproducer_thread(void *p) {
+    struct producer *producer = (struct producer *)p;
+    for (int i = 0; i < producer->count; i++) {
+        while (!equeue_call(producer->q, simple_func, producer->touched)) {
+            usleep(100);
+        }
+    }
+    return 0;
+}
+
+void multiproducer_test(int N) {
     equeue_t q;
     int err = equeue_create(&q, 2048);
     test_assert(!err);
 
-    int id = equeue_call_in(&q, 20, pass_func, 0);
+    int touched = 0;
+    pthread_t thread;
+    err = pthread_create(&thread, 0, multithread_thread, &q);
+    test_assert(!err);
+
+    struct producer producers[4];
+    for (int i = 0; i < 4; i++) {
+        producers[i].q = &q;
+        producers[i].touched = &touched;
+        producers[i].count = N;
+        err = pthread_create(&producers[i].thread, 0,
+                multiproducer_thread, &producers[i]);
+        test_assert(!err);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(producers[i].thread, 0);
+        test_assert(!err);
+    }
+
+    usleep(10000);
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    test_assert(touched == 4*N);
+
+    equeue_destroy(&q);
+}
+
+// overflow slabs would keep the buffer from filling up
+#if defined(EQUEUE_MAGAZINES) && !defined(EQUEUE_SLABS)
+struct magazine_user {
+    pthread_t thread;
+    equeue_t *q;
+    int count;
+    int allocated;
+};
+
+void *magazine_thread(void *p) {
+    struct magazine_user *u = (struct magazine_user *)p;
+    void *es[u->count];
+    for (int i = 0; i < u->count; i++) {
+        es[i] = equeue_alloc(u->q, 2*sizeof(void*));
+        if (es[i]) {
+            u->allocated += 1;
+        }
+    }
+
+    for (int i = 0; i < u->count; i++) {
+        if (es[i]) {
+            equeue_dealloc(u->q, es[i]);
+        }
+    }
+    return 0;
+}
+
+void magazine_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 8*N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    // find how many events fit in the buffer
+    void *es[8*N];
+    int count = 0;
+    while (count < 8*N && (es[count] = equeue_alloc(&q, 2*sizeof(void*)))) {
+        count += 1;
+    }
+    test_assert(count >= 4*N);
+
+    for (int i = 0; i < count; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    // leave freed chunks cached in the threads' magazines
+    struct magazine_user users[4];
+    for (int i = 0; i < 4; i++) {
+        users[i].q = &q;
+        users[i].count = N;
+        users[i].allocated = 0;
+        err = pthread_create(&users[i].thread, 0,
+                magazine_thread, &users[i]);
+        test_assert(!err);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(users[i].thread, 0);
+        test_assert(!err);
+        test_assert(users[i].allocated == N);
+    }
+
+    // the whole buffer is still available to another thread
+    for (int i = 0; i < count; i++) {
+        es[i] = equeue_alloc(&q, 2*sizeof(void*));
+        test_assert(es[i]);
+    }
+    test_assert(!equeue_alloc(&q, 2*sizeof(void*)));
+
+    for (int i = 0; i < count; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    struct equeue_stats s;
+    equeue_stats(&q, &s);
+    size_t free = 0;
+    for (int i = 0; i < EQUEUE_CHUNK_CLASSES; i++) {
+        free += s.chunks[i];
+    }
+    test_assert(free == s.slab_used);
+
+    equeue_destroy(&q);
+}
+#endif
+
+struct worker {
+    int touched;
+    int running;
+    bool overlapped;
+};
+
+void worker_func(void *p) {
+    usleep(10000);
+    __sync_fetch_and_add((int *)p, 1);
+}
+
+void worker_periodic_func(void *p) {
+    struct worker *w = (struct worker *)p;
+    if (__sync_fetch_and_add(&w->running, 1) != 0) {
+        w->overlapped = true;
+    }
+    usleep(2000);
+    __sync_fetch_and_sub(&w->running, 1);
+    __sync_fetch_and_add(&w->touched, 1);
+}
+
+void workerpool_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        err = pthread_create(&threads[i], 0, multithread_thread, &q);
+        test_assert(!err);
+    }
+
+    // slow events are spread over the workers once they are running
+    usleep(10000);
+    int touched = 0;
+    for (int i = 0; i < N; i++) {
+        int id = equeue_call(&q, worker_func, &touched);
+        test_assert(id);
+    }
+
+    usleep(N*10000/2);
+    test_assert(touched == N);
+
+    // periodic events never overlap and stop once cancelled
+    struct worker w = {0, 0, false};
+    int id = equeue_call_every(&q, 1, worker_periodic_func, &w);
     test_assert(id);
 
-    unsigned ms;
-    equeue_background(&q, background_func, &ms);
-    test_assert(ms == 20);
+    usleep(20000);
+    equeue_cancel(&q, id);
+    usleep(5000);
+    int count = w.touched;
+    usleep(10000);
+    test_assert(count > 0 && w.touched == count);
+    test_assert(!w.overlapped);
 
-    id = equeue_call_in(&q, 10, pass_func, 0);
+    for (int i = 0; i < 4; i++) {
+        equeue_break(&q);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(threads[i], 0);
+        test_assert(!err);
+    }
+
+    equeue_destroy(&q);
+}
+
+void steal_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // nothing to steal from a queue without a dispatch loop
+    int touched = 0;
+    int id = equeue_call(&q, simple_func, &touched);
     test_assert(id);
-    test_assert(ms == 10);
+    test_assert(!equeue_steal(&q));
 
-    id = equeue_call(&q, pass_func, 0);
+    pthread_t thread;
+    err = pthread_create(&thread, 0, multithread_thread, &q);
+    test_assert(!err);
+
+    usleep(10000);
+    test_assert(touched == 1);
+
+    // events posted while the dispatch loop is busy can be stolen
+    int slow = 0;
+    id = equeue_call(&q, sloth_func, &slow);
+    test_assert(id);
+    usleep(2000);
+    id = equeue_call(&q, simple_func, &touched);
     test_assert(id);
-    test_assert(ms == 0);
 
-    equeue_dispatch(&q, 0);
-    test_assert(ms == 10);
+    test_assert(equeue_steal(&q));
+    test_assert(touched == 2 && slow == 0);
+    test_assert(!equeue_steal(&q));
+
+    usleep(20000);
+    test_assert(slow == 1);
+
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
 
     equeue_destroy(&q);
-    test_assert(ms == -1);
 }
 
+void busy_hook(void *p) {
+    (*(int *)p)++;
+}
+
+void busy_hook_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int busy = 0;
+    equeue_set_busy_hook(&q, busy_hook, &busy);
+
+    pthread_t thread;
+    err = pthread_create(&thread, 0, multithread_thread, &q);
+    test_assert(!err);
+    usleep(10000);
+
+    // the hook fires for expired events left behind a busy dispatch loop,
+    // and those events are not taken in bulk so they can still be stolen
+    int slow = 0;
+    int touched = 0;
+    int id = equeue_call(&q, sloth_func, &slow);
+    test_assert(id);
+    id = equeue_call(&q, simple_func, &touched);
+    test_assert(id);
+    usleep(2000);
+
+    test_assert(busy >= 1);
+    test_assert(equeue_steal(&q));
+    test_assert(touched == 1 && slow == 0);
+
+    // delayed events don't need a sibling
+    busy = 0;
+    id = equeue_call_in(&q, 5, simple_func, &touched);
+    test_assert(id);
+    test_assert(busy == 0);
+
+    usleep(20000);
+    test_assert(slow == 1 && touched == 2);
+
+    equeue_break(&q);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+
+    equeue_destroy(&q);
+}
+
+void highres_func(void *p) {
+    equeue_tick_t *tick = (equeue_tick_t *)p;
+    *tick = equeue_tick();
+}
+
+void highres_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // sub-millisecond delays are rounded up to the tick, but never early
+    equeue_tick_t start = equeue_tick();
+    equeue_tick_t tick = start;
+    int id = equeue_call_in_us(&q, 500, highres_func, &tick);
+    test_assert(id);
+
+    equeue_dispatch(&q, 10);
+    test_assert(tick != start);
+    test_assert((uint64_t)(tick - start)*EQUEUE_TICK_NS >= 500000);
+
+    start = equeue_tick();
+    tick = start;
+    id = equeue_call_in_ns(&q, 250000, highres_func, &tick);
+    test_assert(id);
+
+    equeue_dispatch(&q, 10);
+    test_assert(tick != start);
+    test_assert((uint64_t)(tick - start)*EQUEUE_TICK_NS >= 250000);
+
+    // periodic events keep their sub-millisecond period
+    int touched = 0;
+    id = equeue_call_every_us(&q, 250, simple_func, &touched);
+    test_assert(id);
+
+    equeue_dispatch(&q, 10);
+    test_assert(touched >= 2);
+    equeue_cancel(&q, id);
+
+    // negative periods still disable repetition
+    touched = 0;
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+    i->touched = &touched;
+    equeue_event_delay_us(i, 100);
+    equeue_event_period_us(i, -1);
+    id = equeue_post(&q, indirect_func, i);
+    test_assert(id);
+
+    equeue_dispatch(&q, 10);
+    test_assert(touched == 1);
+
+    equeue_destroy(&q);
+}
+
+struct stamp {
+    equeue_tick_t *tick;
+};
+
+void stamp_func(void *p) {
+    struct stamp *stamp = (struct stamp *)p;
+    *stamp->tick = equeue_tick();
+}
+
+void slack_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    equeue_tick_t ticks[N];
+    equeue_tick_t start = equeue_tick();
+    for (int i = 0; i < N; i++) {
+        struct stamp *stamp = equeue_alloc(&q, sizeof(struct stamp));
+        test_assert(stamp);
+        stamp->tick = &ticks[i];
+        equeue_event_delay(stamp, 20 + i);
+        equeue_event_slack(stamp, N);
+        int id = equeue_post(&q, stamp_func, stamp);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 20 + 3*N);
+
+    // events are never early, and overlapping windows share a few wakeups
+    // instead of one wakeup per event
+    int wakeups = 0;
+    for (int i = 0; i < N; i++) {
+        equeue_tick_t elapsed = (ticks[i] - start) / EQUEUE_TICKS_PER_MS;
+        test_assert(elapsed >= (equeue_tick_t)(20 + i));
+        if (i == 0 || ticks[i] - ticks[i-1] > EQUEUE_TICKS_PER_MS) {
+            wakeups += 1;
+        }
+    }
+
+    test_assert(wakeups <= 4);
+
+    equeue_destroy(&q);
+}
+
+void batch_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*(EQUEUE_EVENT_SIZE+sizeof(struct indirect)));
+    test_assert(!err);
+
+    int touched[N];
+    void *data[N];
+    int ids[N];
+    for (int i = 0; i < N; i++) {
+        touched[i] = 0;
+        data[i] = &touched[i];
+    }
+
+    int count = equeue_call_batch(&q, simple_func, data, ids, N);
+    test_assert(count == N);
+    for (int i = 0; i < N; i++) {
+        test_assert(ids[i]);
+    }
+
+    equeue_cancel(&q, ids[N-1]);
+    equeue_dispatch(&q, 0);
+    for (int i = 0; i < N; i++) {
+        test_assert(touched[i] == (i < N-1));
+    }
+
+    // batched events keep their own delays
+    void *es[N];
+    count = equeue_alloc_batch(&q, sizeof(struct indirect), es, N);
+    test_assert(count == N);
+    for (int i = 0; i < N; i++) {
+        struct indirect *e = es[i];
+        e->touched = &touched[i];
+        equeue_event_delay(e, (i % 2) ? 10 : 0);
+    }
+
+    equeue_post_batch(&q, indirect_func, es, 0, N);
+    equeue_dispatch(&q, 0);
+    for (int i = 0; i < N; i++) {
+        test_assert(touched[i] == (i < N-1) + !(i % 2));
+    }
+
+    equeue_dispatch(&q, 20);
+    for (int i = 0; i < N; i++) {
+        test_assert(touched[i] == (i < N-1) + 1);
+    }
+
+    // running out of memory posts only part of the batch
+    int more[2*N*TEST_SLABS];
+    void *moredata[2*N*TEST_SLABS];
+    for (int i = 0; i < 2*N*TEST_SLABS; i++) {
+        moredata[i] = &touched[0];
+    }
+
+    count = equeue_call_batch(&q, pass_func, moredata, more, 2*N*TEST_SLABS);
+    test_assert(count > 0 && count < 2*N*TEST_SLABS);
+    test_assert(more[count-1] && !more[count]);
+
+    equeue_destroy(&q);
+}
+
+void cancel_many_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*(EQUEUE_EVENT_SIZE+sizeof(struct indirect)));
+    test_assert(!err);
+
+    int touched = 0;
+    int destroyed = 0;
+    int ids[N+2];
+    bool results[N+2];
+
+    for (int i = 0; i < N; i++) {
+        struct indirect *e = equeue_alloc(&q, sizeof(struct indirect));
+        test_assert(e);
+
+        e->touched = &destroyed;
+        equeue_event_dtor(e, indirect_func);
+        equeue_event_delay(e, (i == 0) ? 0 : 10);
+        ids[i] = equeue_post(&q, pass_func, e);
+        test_assert(ids[i]);
+    }
+
+    // the first event is dispatched before it can be cancelled
+    equeue_dispatch(&q, 0);
+    test_assert(destroyed == 1);
+
+    // null and repeated ids are not cancelled
+    ids[N] = 0;
+    ids[N+1] = ids[N-1];
+
+    int count = equeue_cancel_many(&q, ids, results, N+2);
+    test_assert(count == N-1);
+    test_assert(destroyed == N);
+    for (int i = 0; i < N+2; i++) {
+        test_assert(results[i] == (i > 0 && i < N));
+    }
+
+    // cancelled memory is available again
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_call_in(&q, 10, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    count = equeue_cancel_many(&q, ids, 0, N/2);
+    test_assert(count == N/2);
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == N - N/2);
+
+    equeue_destroy(&q);
+}
+
+size_t stats_free(struct equeue_stats *s) {
+    size_t free = 0;
+    for (int c = 0; c < EQUEUE_CHUNK_CLASSES; c++) {
+        free += s->chunks[c];
+    }
+    return free;
+}
+
+struct stats_snapshot {
+    equeue_t *q;
+    struct equeue_stats s;
+};
+
+void stats_func(void *p) {
+    struct stats_snapshot *snapshot = (struct stats_snapshot *)p;
+    equeue_stats(snapshot->q, &snapshot->s);
+}
+
+void stats_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    int ids[N];
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_call_in(&q, 10, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    equeue_cancel(&q, ids[0]);
+
+    struct equeue_stats s;
+    equeue_stats(&q, &s);
+    test_assert(s.posts == (uint64_t)N);
+    test_assert(s.cancels == 1);
+    test_assert(s.dispatches == 0);
+    test_assert(s.pending == (unsigned)(N-1));
+    test_assert(s.pending_high == (unsigned)N);
+    test_assert(s.slab_used > 0);
+    test_assert(s.slab_high == s.slab_used);
+    test_assert(s.chunks_used == (unsigned)(N-1));
+    test_assert(s.bytes_used + stats_free(&s) == s.slab_used);
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == N-1);
+
+    // every chunk is free again
+    equeue_stats(&q, &s);
+    test_assert(s.dispatches == (uint64_t)(N-1));
+    test_assert(s.pending == 0);
+    test_assert(s.pending_high == (unsigned)N);
+    test_assert(s.alloc_failures == 0);
+    test_assert(s.chunks_used == 0 && s.bytes_used == 0);
+    test_assert(stats_free(&s) == s.slab_used);
+
+    // events are dispatched once their callback runs
+    struct stats_snapshot snapshot = {&q, {0}};
+    test_assert(equeue_call(&q, stats_func, &snapshot));
+    equeue_dispatch(&q, 0);
+    test_assert(snapshot.s.dispatches == (uint64_t)(N-1));
+    test_assert(snapshot.s.pending == 1);
+    test_assert(snapshot.s.chunks_used == 1);
+    equeue_stats(&q, &s);
+    test_assert(s.dispatches == (uint64_t)N);
+    test_assert(s.pending == 0);
+
+    // events cancelled while in flight count as cancelled
+    struct cancel *cancel = equeue_alloc(&q, sizeof(struct cancel));
+    test_assert(cancel);
+    cancel->q = &q;
+    equeue_post(&q, cancel_func, cancel);
+    cancel->id = equeue_call(&q, simple_func, &touched);
+    test_assert(cancel->id);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == N-1);
+    equeue_stats(&q, &s);
+    test_assert(s.dispatches == (uint64_t)(N+1));
+    test_assert(s.cancels == 2);
+    test_assert(s.pending == 0);
+
+    test_assert(!equeue_alloc(&q, 4096));
+    equeue_stats(&q, &s);
+    test_assert(s.alloc_failures == 1);
+    test_assert(stats_free(&s) == s.slab_used);
+    test_assert(s.slab_high >= s.slab_used);
+
+    equeue_destroy(&q);
+}
+
+void reschedule_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // postpone a pending event
+    int touched = 0;
+    int id = equeue_call_in(&q, 10, simple_func, &touched);
+    test_assert(id);
+    test_assert(equeue_reschedule(&q, id, 40));
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == 0);
+    equeue_dispatch(&q, 30);
+    test_assert(touched == 1);
+
+    // dispatched events can't be rescheduled
+    test_assert(!equeue_reschedule(&q, id, 10));
+    test_assert(!equeue_reschedule(&q, 0, 10));
+
+    // bring a pending event forward, it keeps its id
+    id = equeue_call_in(&q, 1000, simple_func, &touched);
+    test_assert(equeue_reschedule_us(&q, id, 0));
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2);
+
+    id = equeue_call_in(&q, 1000, simple_func, &touched);
+    test_assert(equeue_reschedule_ns(&q, id, 10*1000*1000));
+    equeue_cancel(&q, id);
+    test_assert(!equeue_reschedule(&q, id, 0));
+    equeue_dispatch(&q, 20);
+    test_assert(touched == 2);
+
+    // periodic events continue from the new expiry
+    id = equeue_call_every(&q, 20, simple_func, &touched);
+    test_assert(equeue_reschedule(&q, id, 50));
+    equeue_dispatch(&q, 40);
+    test_assert(touched == 2);
+    equeue_dispatch(&q, 40);
+    test_assert(touched == 4);
+
+    equeue_destroy(&q);
+}
+
+#ifdef EQUEUE_SLABS
+void grow_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 4*EQUEUE_EVENT_SIZE + 32);
+    test_assert(!err);
+
+    // events overflow into new slabs once the buffer is exhausted
+    int N = 4*(EQUEUE_SLABS+1);
+    int ids[N];
+    int touched = 0;
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_call_in(&q, 10, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    test_assert(!equeue_call(&q, pass_func, 0));
+
+    // ids of events in overflow slabs still decode
+    equeue_cancel(&q, ids[N-1]);
+    test_assert(equeue_reschedule(&q, ids[N-2], 0));
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == N-1);
+
+    // idle overflow slabs are freed, stale ids are safely ignored
+    for (int i = 0; i < EQUEUE_SLABS; i++) {
+        test_assert(!q.slabs[i].data);
+    }
+
+    equeue_cancel(&q, ids[N-2]);
+    test_assert(!equeue_reschedule(&q, ids[N-1], 0));
+
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_call(&q, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2*N-1);
+
+    equeue_destroy(&q);
+}
+
+void id_wrap_test(void) {
+    // a buffer this large leaves fewer bits for the local id than it
+    // holds, so reusing a chunk wraps its id
+    equeue_t q;
+    int err = equeue_create(&q, 1 << 20);
+    test_assert(!err);
+
+    int touched = 0;
+    for (int i = 0; i < 600; i++) {
+        int id = equeue_call(&q, simple_func, &touched);
+        test_assert(id > 0);
+        equeue_cancel(&q, id);
+        equeue_dispatch(&q, 0);
+        test_assert(touched == 0);
+    }
+
+    equeue_destroy(&q);
+}
+
+void slab_reuse_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 4*EQUEUE_EVENT_SIZE + 32);
+    test_assert(!err);
+
+    // fill the buffer so the next event lands in an overflow slab
+    int ids[4];
+    int touched = 0;
+    for (int i = 0; i < 4; i++) {
+        ids[i] = equeue_call_in(&q, 1000, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    int stale = equeue_call(&q, simple_func, &touched);
+    test_assert(stale);
+    equeue_dispatch(&q, 10);
+    test_assert(touched == 1);
+    test_assert(!q.slabs[0].data);
+
+    // a slab grown again at the same index does not reuse the ids of the
+    // trimmed slab, so cancelling the stale id leaves the new event alone
+    int id = equeue_call_in(&q, 1000, simple_func, &touched);
+    test_assert(id && id != stale);
+    test_assert(q.slabs[0].data);
+
+    equeue_cancel(&q, stale);
+    test_assert(equeue_reschedule(&q, id, 0));
+    equeue_dispatch(&q, 10);
+    test_assert(touched == 2);
+
+    for (int i = 0; i < 4; i++) {
+        equeue_cancel(&q, ids[i]);
+    }
+
+    equeue_destroy(&q);
+}
+#endif
+
+// overflow slabs would keep the buffer from filling up
+#if defined(EQUEUE_COALESCE) && !defined(EQUEUE_SLABS)
+void coalesce_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    // carve the buffer into small events
+    void *es[N*EQUEUE_EVENT_SIZE/sizeof(struct equeue_event)];
+    int n = 0;
+    while ((es[n] = equeue_alloc(&q, 0))) {
+        n++;
+    }
+    test_assert(n > 2);
+
+    equeue_event_delay(es[1], 1000);
+    int id = equeue_post(&q, pass_func, es[1]);
+    test_assert(id);
+    equeue_cancel(&q, id);
+
+    for (int i = 0; i < n; i++) {
+        if (i != 1) {
+            equeue_dealloc(&q, es[i]);
+        }
+    }
+
+    // freed events merge back into one large event
+    size_t size = (n-1)*sizeof(struct equeue_event);
+    unsigned char *p = equeue_alloc(&q, size);
+    test_assert(p);
+    memset(p, 0xcc, size);
+
+    // stale ids into merged events are ignored
+    equeue_cancel(&q, id);
+    test_assert(!equeue_reschedule(&q, id, 0));
+    for (size_t i = 0; i < size; i++) {
+        test_assert(p[i] == 0xcc);
+    }
+
+    // and large events are split for small events
+    equeue_dealloc(&q, p);
+    for (int i = 0; i < n; i++) {
+        es[i] = equeue_alloc(&q, 0);
+        test_assert(es[i]);
+    }
+
+    equeue_destroy(&q);
+}
+#endif
+
+void background_func(void *p, int ms) {
+    *(unsigned *)p = ms;
+}
+
+struct hooks {
+    int before;
+    int after;
+    int id;
+    equeue_tick_t start;
+};
+
+void before_hook(void *ctx, void *event, int id,
+        void (*cb)(void *), equeue_tick_t start) {
+    struct hooks *hooks = (struct hooks *)ctx;
+    test_assert(hooks->before == hooks->after);
+    test_assert(event && cb == indirect_func);
+    hooks->before += 1;
+    hooks->id = id;
+    hooks->start = start;
+}
+
+void after_hook(void *ctx, void *event, int id,
+        void (*cb)(void *), equeue_tick_t start, equeue_tick_t end) {
+    struct hooks *hooks = (struct hooks *)ctx;
+    test_assert(hooks->before == hooks->after + 1);
+    test_assert(event && cb == indirect_func);
+    test_assert(id == hooks->id && start == hooks->start);
+    test_assert((equeue_delta_t)(end - start) >= 0);
+    hooks->after += 1;
+}
+
+void hooks_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    struct hooks hooks = {0};
+    equeue_set_hooks(&q, before_hook, after_hook, &hooks);
+
+    int touched = 0;
+    struct indirect *e = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(e);
+    e->touched = &touched;
+    int id = equeue_post(&q, indirect_func, e);
+    test_assert(id);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+    test_assert(hooks.before == 1 && hooks.after == 1);
+    test_assert(hooks.id == id);
+
+    // cancelled events are not hooked
+    e = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(e);
+    e->touched = &touched;
+    id = equeue_post(&q, indirect_func, e);
+    equeue_cancel(&q, id);
+    equeue_dispatch(&q, 0);
+    test_assert(hooks.before == 1);
+
+    equeue_set_hooks(&q, 0, 0, 0);
+    e = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(e);
+    e->touched = &touched;
+    equeue_post(&q, indirect_func, e);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2);
+    test_assert(hooks.before == 1 && hooks.after == 1);
+
+    equeue_destroy(&q);
+}
+
+void *spin_break_thread(void *p) {
+    usleep(5000);
+    equeue_break((equeue_t *)p);
+    return 0;
+}
+
+void spin_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // deadlines within the budget are spun for
+    equeue_set_spin_ns(&q, 5*1000*1000);
+    int touched = 0;
+    equeue_call_in(&q, 2, simple_func, &touched);
+    equeue_dispatch(&q, 3);
+    test_assert(touched == 1);
+
+    struct equeue_stats s;
+    equeue_stats(&q, &s);
+    test_assert(s.spins >= 1);
+    test_assert(s.parks == 0);
+
+    // deadlines past the budget park until they come within it
+    equeue_call_in(&q, 20, simple_func, &touched);
+    equeue_dispatch(&q, 25);
+    test_assert(touched == 2);
+
+    equeue_stats(&q, &s);
+    test_assert(s.parks >= 1);
+
+    // breaks end a spin
+    equeue_set_spin_ns(&q, 50*1000*1000);
+    int id = equeue_call_in(&q, 40, simple_func, &touched);
+    test_assert(id);
+    pthread_t thread;
+    err = pthread_create(&thread, 0, spin_break_thread, &q);
+    test_assert(!err);
+    equeue_tick_t start = equeue_tick();
+    equeue_dispatch(&q, -1);
+    test_assert(equeue_tick() - start < 30*EQUEUE_TICKS_PER_MS);
+    test_assert(touched == 2);
+    err = pthread_join(thread, 0);
+    test_assert(!err);
+    equeue_cancel(&q, id);
+
+    // without a budget the dispatch loop parks
+    equeue_stats(&q, &s);
+    uint64_t spins = s.spins;
+    equeue_set_spin_ns(&q, 0);
+    equeue_call_in(&q, 2, simple_func, &touched);
+    equeue_dispatch(&q, 3);
+    test_assert(touched == 3);
+
+    equeue_stats(&q, &s);
+    test_assert(s.spins == spins);
+
+    equeue_destroy(&q);
+}
+
+#ifdef EQUEUE_TRACE
+void trace_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    struct indirect *e = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(e);
+    e->touched = &touched;
+    int id1 = equeue_post(&q, indirect_func, e);
+    int id2 = equeue_call_in(&q, 10, simple_func, &touched);
+    equeue_cancel(&q, id2);
+    test_assert(!equeue_alloc(&q, 4096));
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+
+    struct equeue_trace_record records[EQUEUE_TRACE];
+    unsigned count = equeue_trace_dump(&q, records, EQUEUE_TRACE);
+
+    // post and wheel records may interleave with ingress
+    const struct {
+        uint8_t type;
+        int id;
+    } expected[] = {
+        {EQUEUE_TRACE_CANCEL,    id2},
+        {EQUEUE_TRACE_ALLOCFAIL, 0},
+        {EQUEUE_TRACE_DEQUEUE,   id1},
+        {EQUEUE_TRACE_DISPATCH,  id1},
+        {EQUEUE_TRACE_DONE,      id1},
+    };
+    unsigned found = 0;
+    unsigned posts = 0;
+    unsigned enqueues = 0;
+    for (unsigned i = 0; i < count; i++) {
+        test_assert(records[i].seq == i+1);
+        test_assert(records[i].queue == (uint32_t)(uintptr_t)&q);
+        if (i > 0) {
+            test_assert(records[i].time >= records[i-1].time);
+        }
+
+        if (records[i].type == EQUEUE_TRACE_POST) {
+            test_assert(records[i].id == (posts ? id2 : id1));
+            test_assert(records[i].arg != 0);
+            posts += 1;
+        } else if (records[i].type == EQUEUE_TRACE_ENQUEUE &&
+                records[i].id == id2) {
+            // the delay is recorded even for events spliced from ingress
+            test_assert(records[i].arg <= 10);
+            enqueues += 1;
+        } else if (found < sizeof(expected)/sizeof(expected[0]) &&
+                records[i].type == expected[found].type) {
+            test_assert(records[i].id == expected[found].id);
+            found += 1;
+        }
+    }
+    test_assert(posts == 2);
+    test_assert(enqueues == 1);
+    test_assert(found == sizeof(expected)/sizeof(expected[0]));
+
+    // only the most recent records are kept
+    for (int i = 0; i < EQUEUE_TRACE; i++) {
+        equeue_call(&q, pass_func, 0);
+        equeue_dispatch(&q, 0);
+    }
+    count = equeue_trace_dump(&q, records, 4);
+    test_assert(count == 4);
+    test_assert(records[3].type == EQUEUE_TRACE_DONE);
+    test_assert(records[3].seq - records[0].seq == 3);
+
+    equeue_destroy(&q);
+}
+#endif
+
+void background_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int id = equeue_call_in(&q, 20, pass_func, 0);
+    test_assert(id);
+
+    unsigned ms;
+    equeue_background(&q, background_func, &ms);
+    test_assert(ms == 20);
+
+    id = equeue_call_in(&q, 10, pass_func, 0);
+    test_assert(id);
+    test_assert(ms == 10);
+
+    id = equeue_call(&q, pass_func, 0);
+    test_assert(id);
+    test_assert(ms == 0);
+
+    equeue_dispatch(&q, 0);
+    test_assert(ms == 10);
+
+    equeue_destroy(&q);
+    test_assert(ms == -1);
+}
+
+#ifdef EQUEUE_FD
+bool fd_ready(int fd, int ms) {
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    return poll(&pfd, 1, ms) == 1 && (pfd.revents & POLLIN);
+}
+
+void fd_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int fd = equeue_fd(&q);
+    test_assert(fd >= 0);
+    test_assert(equeue_fd(&q) == fd);
+    test_assert(!fd_ready(fd, 0));
+
+    // the timer becomes readable at the event's target
+    int touched = 0;
+    equeue_call_in(&q, 10, simple_func, &touched);
+    test_assert(!fd_ready(fd, 0));
+    test_assert(fd_ready(fd, 100));
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+    test_assert(!fd_ready(fd, 0));
+
+    // immediate posts are signalled through the eventfd
+    equeue_call(&q, simple_func, &touched);
+    test_assert(fd_ready(fd, 0));
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2);
+    test_assert(!fd_ready(fd, 0));
+
+    // remaining events rearm the descriptor
+    equeue_call(&q, simple_func, &touched);
+    equeue_call_in(&q, 10, simple_func, &touched);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 3);
+    test_assert(!fd_ready(fd, 0));
+    test_assert(fd_ready(fd, 100));
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 4);
+
+    equeue_destroy(&q);
+}
+#endif
+
+#ifdef EQUEUE_TIMERFD
+void timerfd_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    equeue_call_in(&q, 10, simple_func, &touched);
+
+    err = equeue_background_timerfd(&q);
+    test_assert(!err);
+    err = equeue_background_timerfd(&q);
+    test_assert(!err);
+
+    // pending events are dispatched by the thread
+    usleep(5*1000);
+    test_assert(touched == 0);
+    usleep(50*1000);
+    test_assert(touched == 1);
+
+    // so are events posted afterwards
+    equeue_call(&q, simple_func, &touched);
+    equeue_call_in(&q, 5, simple_func, &touched);
+    usleep(50*1000);
+    test_assert(touched == 3);
+
+    // replacing the background timer stops the thread
+    equeue_background(&q, 0, 0);
+    equeue_call(&q, simple_func, &touched);
+    usleep(20*1000);
+    test_assert(touched == 3);
+
+    err = equeue_background_timerfd(&q);
+    test_assert(!err);
+    usleep(20*1000);
+    test_assert(touched == 4);
+
+    equeue_call_every(&q, 1, simple_func, &touched);
+    usleep(20*1000);
+    test_assert(touched > 5);
+
+    equeue_destroy(&q);
+}
+#endif
+
+#ifdef EQUEUE_REACTOR
+struct reactor_watch {
+    equeue_t *q;
+    struct equeue_watch *w;
+    int fd;
+    int count;
+};
+
+void reactor_func(void *p) {
+    struct reactor_watch *r = (struct reactor_watch *)p;
+    char c;
+    while (read(r->fd, &c, 1) == 1) {
+        r->count += 1;
+    }
+
+    if (r->count >= 3) {
+        equeue_unwatch_fd(r->q, r->w);
+    }
+}
+
+void reactor_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int fds[2];
+    err = pipe(fds);
+    test_assert(!err);
+    err = fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    test_assert(!err);
+
+    struct reactor_watch r = {&q, 0, fds[0], 0};
+    r.w = equeue_watch_fd(&q, fds[0], EPOLLIN, reactor_func, &r);
+    test_assert(r.w);
+
+    // nothing to read
+    equeue_dispatch(&q, 10);
+    test_assert(r.count == 0);
+
+    // readiness is dispatched alongside events
+    int touched = 0;
+    test_assert(write(fds[1], "a", 1) == 1);
+    equeue_call(&q, simple_func, &touched);
+    equeue_dispatch(&q, 10);
+    test_assert(r.count == 1);
+    test_assert(touched == 1);
+
+    // timeouts still expire while sleeping in the reactor
+    equeue_call_in(&q, 5, simple_func, &touched);
+    equeue_dispatch(&q, 20);
+    test_assert(touched == 2);
+
+    // the watch is rearmed after each callback
+    test_assert(write(fds[1], "bc", 2) == 2);
+    equeue_dispatch(&q, 10);
+    test_assert(r.count == 3);
+
+#ifdef EQUEUE_TRACE
+    // posting the readiness does not signal the loop that is posting it,
+    // which would cost another pass through epoll_wait before the timeout
+    struct equeue_trace_record records[64];
+    unsigned n = equeue_trace_dump(&q, records, 64);
+    unsigned post = n;
+    for (unsigned i = 0; i < n; i++) {
+        if (records[i].type == EQUEUE_TRACE_POST) {
+            post = i;
+        }
+    }
+    test_assert(post < n);
+
+    unsigned sleeps = 0;
+    for (unsigned i = post; i < n; i++) {
+        sleeps += records[i].type == EQUEUE_TRACE_SLEEP;
+    }
+    test_assert(sleeps == 1);
+#endif
+
+    // the callback unwatched the descriptor
+    test_assert(write(fds[1], "d", 1) == 1);
+    equeue_dispatch(&q, 10);
+    test_assert(r.count == 3);
+
+    close(fds[0]);
+    close(fds[1]);
+    equeue_destroy(&q);
+}
+#endif
+
 void chain_test(void) {
     equeue_t q1;
     int err = equeue_create(&q1, 2048);
@@ -690,14 +2095,59 @@ int main() {
     test_run(cancel_inflight_test);
     test_run(cancel_unnecessarily_test);
     test_run(loop_protect_test);
+    test_run(order_test, 64);
+    test_run(priority_test, 20);
+#ifdef EQUEUE_EDF
+    test_run(edf_test, 64);
+#endif
+#ifdef EQUEUE_HISTOGRAMS
+    test_run(histogram_test, 20);
+#endif
     test_run(break_test);
     test_run(period_test);
     test_run(nested_test);
     test_run(sloth_test);
+    test_run(highres_test);
+    test_run(slack_test, 16);
+    test_run(batch_test, 20);
+    test_run(batch_test, 200);
+    test_run(cancel_many_test, 20);
+    test_run(stats_test, 20);
+    test_run(reschedule_test);
+#ifdef EQUEUE_SLABS
+    test_run(grow_test);
+    test_run(id_wrap_test);
+    test_run(slab_reuse_test);
+#endif
+#if defined(EQUEUE_COALESCE) && !defined(EQUEUE_SLABS)
+    test_run(coalesce_test, 20);
+#endif
+    test_run(hooks_test);
+    test_run(spin_test);
+#ifdef EQUEUE_TRACE
+    test_run(trace_test);
+#endif
     test_run(background_test);
+#ifdef EQUEUE_FD
+    test_run(fd_test);
+#endif
+#ifdef EQUEUE_REACTOR
+    test_run(reactor_test);
+#endif
+#ifdef EQUEUE_TIMERFD
+    test_run(timerfd_test);
+#endif
     test_run(chain_test);
     test_run(unchain_test);
     test_run(multithread_test);
+    test_run(wakeup_test);
+    test_run(multiproducer_test, 1000);
+#if defined(EQUEUE_MAGAZINES) && !defined(EQUEUE_SLABS)
+    test_run(magazine_test, 40);
+#endif
+    test_run(workerpool_test, 8);
+    test_run(steal_test);
+    test_run(busy_hook_test);
     test_run(simple_barrage_test, 20);
     test_run(fragmenting_barrage_test, 20);
     test_run(multithreaded_barrage_test, 20);
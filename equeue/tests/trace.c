@@ -0,0 +1,160 @@
+/*
+ * Convert event queue trace dumps into Chrome trace JSON
+ *
+ * Dumps are files of the records returned by equeue_trace_dump, the
+ * resulting JSON can be loaded into chrome://tracing or Perfetto.
+ *
+ * usage: tests/trace dump... > trace.json
+ *
+ * Copyright (c) 2016 Christopher Haster
+ * Distributed under the MIT license
+ */
+#include "equeue.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+
+// Reading dumps
+static struct equeue_trace_record *trace_records;
+static size_t trace_count;
+static size_t trace_capacity;
+
+static int trace_read(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    struct equeue_trace_record r;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (trace_count == trace_capacity) {
+            trace_capacity = trace_capacity ? 2*trace_capacity : 256;
+            trace_records = realloc(trace_records,
+                    trace_capacity*sizeof(struct equeue_trace_record));
+            if (!trace_records) {
+                perror("realloc");
+                fclose(f);
+                return -1;
+            }
+        }
+
+        trace_records[trace_count++] = r;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+// records are ordered by time, records from the same queue with the same
+// time keep their sequence
+static int trace_compare(const void *a, const void *b) {
+    const struct equeue_trace_record *ra = a;
+    const struct equeue_trace_record *rb = b;
+    if (ra->time != rb->time) {
+        return ra->time < rb->time ? -1 : 1;
+    } else if (ra->queue != rb->queue) {
+        return ra->queue < rb->queue ? -1 : 1;
+    } else if (ra->seq != rb->seq) {
+        return ra->seq < rb->seq ? -1 : 1;
+    }
+    return 0;
+}
+
+
+// Writing Chrome trace JSON
+static const char *trace_names[] = {
+    [EQUEUE_TRACE_POST]      = "post",
+    [EQUEUE_TRACE_ENQUEUE]   = "enqueue",
+    [EQUEUE_TRACE_DEQUEUE]   = "dequeue",
+    [EQUEUE_TRACE_DISPATCH]  = "dispatch",
+    [EQUEUE_TRACE_DONE]      = "done",
+    [EQUEUE_TRACE_CANCEL]    = "cancel",
+    [EQUEUE_TRACE_ALLOCFAIL] = "allocfail",
+    [EQUEUE_TRACE_SLEEP]     = "sleep",
+    [EQUEUE_TRACE_WAKE]      = "wake",
+};
+
+// returns false if the record's type is unknown
+static bool trace_write(const struct equeue_trace_record *r, bool first) {
+    const char *name = r->type < sizeof(trace_names)/sizeof(trace_names[0])
+            ? trace_names[r->type] : 0;
+    if (!name) {
+        return false;
+    }
+
+    printf("%s\n    {\"pid\": %" PRIu32 ", \"tid\": %" PRIu32
+            ", \"ts\": %" PRIu64 ".%03u, ",
+            first ? "" : ",", r->queue, r->thread,
+            r->time / 1000, (unsigned)(r->time % 1000));
+
+    // callbacks and sleeps are shown as durations, posts are linked to
+    // their dispatches with flow arrows, everything else is an instant
+    switch (r->type) {
+        case EQUEUE_TRACE_DISPATCH:
+            printf("\"ph\": \"B\", \"name\": \"callback 0x%08" PRIx32 "\", "
+                    "\"args\": {\"id\": %" PRId32 "}},\n", r->arg, r->id);
+            printf("    {\"pid\": %" PRIu32 ", \"tid\": %" PRIu32
+                    ", \"ts\": %" PRIu64 ".%03u, \"ph\": \"f\", "
+                    "\"bp\": \"e\", \"cat\": \"event\", \"name\": \"event\", "
+                    "\"id\": \"%" PRIx32 ":%" PRIx32 "\"}",
+                    r->queue, r->thread,
+                    r->time / 1000, (unsigned)(r->time % 1000),
+                    r->queue, (uint32_t)r->id);
+            break;
+        case EQUEUE_TRACE_DONE:
+        case EQUEUE_TRACE_WAKE:
+            printf("\"ph\": \"E\"}");
+            break;
+        case EQUEUE_TRACE_SLEEP:
+            printf("\"ph\": \"B\", \"name\": \"sleep\", "
+                    "\"args\": {\"timeout\": %" PRId32 "}}", (int32_t)r->arg);
+            break;
+        case EQUEUE_TRACE_POST:
+            printf("\"ph\": \"s\", \"cat\": \"event\", \"name\": \"event\", "
+                    "\"id\": \"%" PRIx32 ":%" PRIx32 "\"},\n",
+                    r->queue, (uint32_t)r->id);
+            printf("    {\"pid\": %" PRIu32 ", \"tid\": %" PRIu32
+                    ", \"ts\": %" PRIu64 ".%03u, ",
+                    r->queue, r->thread,
+                    r->time / 1000, (unsigned)(r->time % 1000));
+            // fall through
+        default:
+            printf("\"ph\": \"i\", \"s\": \"t\", \"name\": \"%s\", "
+                    "\"args\": {\"id\": %" PRId32 ", \"arg\": %" PRIu32 "}}",
+                    name, r->id, r->arg);
+            break;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s dump... > trace.json\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (trace_read(argv[i])) {
+            return 1;
+        }
+    }
+
+    qsort(trace_records, trace_count,
+            sizeof(struct equeue_trace_record), trace_compare);
+
+    printf("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    bool first = true;
+    for (size_t i = 0; i < trace_count; i++) {
+        if (trace_write(&trace_records[i], first)) {
+            first = false;
+        }
+    }
+    printf("\n]}\n");
+
+    free(trace_records);
+    return 0;
+}